@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace std;
@@ -11,8 +17,22 @@ enum class Implementation {
     Optimized
 };
 
+// contiguous ranges (raw pointers, std::vector/std::array iterators) of the same trivially copyable type
 template <typename InIter, typename OutIter>
-Implementation mcopy(InIter start, InIter end, OutIter dest)
+constexpr bool is_bitwise_copyable_v = contiguous_iterator<InIter> && contiguous_iterator<OutIter>
+    && is_same_v<remove_cv_t<iter_value_t<InIter>>, iter_value_t<OutIter>>
+    && is_trivially_copyable_v<iter_value_t<OutIter>>
+    && is_assignable_v<iter_reference_t<OutIter>, iter_reference_t<InIter>>;
+
+template <typename Iter, typename T>
+constexpr bool is_bytewise_fillable_v = contiguous_iterator<Iter>
+    && is_trivially_copyable_v<iter_value_t<Iter>>
+    && sizeof(iter_value_t<Iter>) == 1
+    && is_convertible_v<const T&, iter_value_t<Iter>>
+    && is_assignable_v<iter_reference_t<Iter>, iter_value_t<Iter>>;
+
+template <typename InIter, typename OutIter>
+enable_if_t<!is_bitwise_copyable_v<InIter, OutIter>, Implementation> mcopy(InIter start, InIter end, OutIter dest)
 {
     for (auto it = start; it != end; ++it, ++dest)
     {
@@ -22,7 +42,94 @@ Implementation mcopy(InIter start, InIter end, OutIter dest)
     return Implementation::Generic;
 }
 
-// TODO - optimized version with memcpy of mcopy
+template <typename InIter, typename OutIter>
+enable_if_t<is_bitwise_copyable_v<InIter, OutIter>, Implementation> mcopy(InIter start, InIter end, OutIter dest)
+{
+    const size_t count = end - start;
+    if (count > 0)
+        memcpy(to_address(dest), to_address(start), count * sizeof(iter_value_t<InIter>));
+
+    return Implementation::Optimized;
+}
+
+// true if dest lies inside (start, end) - moving front to back would overwrite elements not moved yet
+template <typename Iter>
+bool is_inside_source(Iter start, Iter end, Iter dest)
+{
+    if constexpr (random_access_iterator<Iter>)
+    {
+        return start < dest && dest < end;
+    }
+    else
+    {
+        for (auto it = start; it != end; ++it)
+        {
+            if (it == dest)
+                return it != start;
+        }
+
+        return false;
+    }
+}
+
+// generic version is safe for any overlap of source and destination (like std::move/std::move_backward)
+template <typename InIter, typename OutIter>
+enable_if_t<!is_bitwise_copyable_v<InIter, OutIter>, Implementation> mmove(InIter start, InIter end, OutIter dest)
+{
+    if constexpr (is_same_v<InIter, OutIter> && bidirectional_iterator<InIter>)
+    {
+        if (is_inside_source(start, end, dest))
+        {
+            move_backward(start, end, next(dest, distance(start, end)));
+            return Implementation::Generic;
+        }
+    }
+
+    for (auto it = start; it != end; ++it, ++dest)
+    {
+        *dest = std::move(*it);
+    }
+
+    return Implementation::Generic;
+}
+
+// optimized version is safe for any overlap of source and destination
+template <typename InIter, typename OutIter>
+enable_if_t<is_bitwise_copyable_v<InIter, OutIter>, Implementation> mmove(InIter start, InIter end, OutIter dest)
+{
+    const size_t count = end - start;
+    if (count > 0)
+        memmove(to_address(dest), to_address(start), count * sizeof(iter_value_t<InIter>));
+
+    return Implementation::Optimized;
+}
+
+template <typename Iter, typename T>
+enable_if_t<!is_bytewise_fillable_v<Iter, T>, Implementation> mfill(Iter start, Iter end, const T& value)
+{
+    for (auto it = start; it != end; ++it)
+    {
+        *it = value;
+    }
+
+    return Implementation::Generic;
+}
+
+// memset writes a single byte pattern - only one-byte types can be filled with it
+template <typename Iter, typename T>
+enable_if_t<is_bytewise_fillable_v<Iter, T>, Implementation> mfill(Iter start, Iter end, const T& value)
+{
+    const size_t count = end - start;
+    if (count > 0)
+    {
+        const iter_value_t<Iter> item = value;
+        unsigned char byte;
+        memcpy(&byte, &item, 1);
+        memset(to_address(start), byte, count);
+    }
+
+    return Implementation::Optimized;
+}
 
 TEST_CASE("mcopy")
 {
@@ -44,12 +151,139 @@ TEST_CASE("mcopy")
         REQUIRE(equal(begin(words), end(words), begin(dest), end(dest)));
     }
 
-    // SECTION("optimized for arrays of POD types")
-    // {
-    //     int tab1[5] = {1, 2, 3, 4, 5};
-    //     int tab2[5];
+    SECTION("optimized for arrays of POD types")
+    {
+        int tab1[5] = {1, 2, 3, 4, 5};
+        int tab2[5];
+
+        REQUIRE(mcopy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
+        REQUIRE(equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+
+    SECTION("optimized for vector & array iterators")
+    {
+        vector<int> vec = {1, 2, 3, 4, 5};
+        array<int, 5> arr{};
+
+        REQUIRE(mcopy(vec.cbegin(), vec.cend(), arr.begin()) == Implementation::Optimized);
+        REQUIRE(equal(vec.begin(), vec.end(), arr.begin(), arr.end()));
+
+        vector<int> target(5);
+        REQUIRE(mcopy(arr.begin(), arr.end(), target.begin()) == Implementation::Optimized);
+        REQUIRE(target == vec);
+    }
+
+    SECTION("generic when value types differ")
+    {
+        int tab1[3] = {1, 2, 3};
+        long tab2[3];
+
+        REQUIRE(mcopy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Generic);
+        REQUIRE(equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+}
+
+struct Point
+{
+    int x, y;
+
+    bool operator==(const Point&) const = default;
+};
+
+TEST_CASE("mmove")
+{
+    SECTION("generic version moves strings")
+    {
+        string words[] = {"one", "two", "three"};
+        vector<string> dest(3);
+
+        REQUIRE(mmove(begin(words), end(words), dest.begin()) == Implementation::Generic);
+        REQUIRE(dest == vector<string>{"one", "two", "three"});
+    }
+
+    SECTION("generic for overlapping ranges of strings")
+    {
+        vector<string> words = {"one", "two", "three", "four", "five"};
+
+        REQUIRE(mmove(words.begin(), words.begin() + 4, words.begin() + 1) == Implementation::Generic);
+        REQUIRE(vector<string>(words.begin() + 1, words.end()) == vector<string>{"one", "two", "three", "four"});
+
+        REQUIRE(mmove(words.begin() + 1, words.end(), words.begin()) == Implementation::Generic);
+        REQUIRE(vector<string>(words.begin(), words.begin() + 4) == vector<string>{"one", "two", "three", "four"});
+
+        list<int> lst = {1, 2, 3, 4, 5};
+        REQUIRE(mmove(lst.begin(), prev(lst.end()), next(lst.begin())) == Implementation::Generic);
+        REQUIRE(lst == list<int>{1, 1, 2, 3, 4});
+    }
+
+    SECTION("optimized for overlapping ranges of POD types")
+    {
+        Point points[5] = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+
+        REQUIRE(mmove(begin(points), begin(points) + 4, begin(points) + 1) == Implementation::Optimized);
+        REQUIRE(equal(begin(points), end(points), begin(vector<Point>{{1, 1}, {1, 1}, {2, 2}, {3, 3}, {4, 4}})));
 
-    //     REQUIRE(mcopy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
-    //     REQUIRE(equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
-    // }
+        REQUIRE(mmove(begin(points) + 1, end(points), begin(points)) == Implementation::Optimized);
+        REQUIRE(equal(begin(points), begin(points) + 4, begin(vector<Point>{{1, 1}, {2, 2}, {3, 3}, {4, 4}})));
+    }
+}
+
+TEST_CASE("mfill")
+{
+    SECTION("generic for ints and strings")
+    {
+        vector<int> vec(5);
+        REQUIRE(mfill(vec.begin(), vec.end(), 42) == Implementation::Generic);
+        REQUIRE(all_of(vec.begin(), vec.end(), [](int x) { return x == 42; }));
+
+        list<string> lst(3);
+        REQUIRE(mfill(lst.begin(), lst.end(), "text"s) == Implementation::Generic);
+        REQUIRE(all_of(lst.begin(), lst.end(), [](const string& s) { return s == "text"; }));
+    }
+
+    SECTION("optimized for byte-sized types")
+    {
+        vector<uint8_t> buffer(100);
+        REQUIRE(mfill(buffer.begin(), buffer.end(), 0xAB) == Implementation::Optimized);
+        REQUIRE(all_of(buffer.begin(), buffer.end(), [](uint8_t x) { return x == 0xAB; }));
+
+        char text[4] = {};
+        REQUIRE(mfill(begin(text), begin(text) + 3, 'x') == Implementation::Optimized);
+        REQUIRE(text == "xxx"s);
+    }
+}
+
+template <typename T>
+void benchmark_copy_family(const string& type_desc, const T& value)
+{
+    for (size_t bytes : {16ul, 1ul << 10, 64ul << 10, 4ul << 20, 256ul << 20, 1ul << 30})
+    {
+        const size_t count = max<size_t>(2, bytes / sizeof(T));
+        vector<T> source(count, value);
+        vector<T> dest(count);
+
+        const string desc = type_desc + " - " + to_string(bytes) + " B";
+
+        BENCHMARK("mcopy " + desc)
+        {
+            return mcopy(source.begin(), source.end(), dest.begin());
+        };
+
+        BENCHMARK("mmove (overlapping) " + desc)
+        {
+            return mmove(dest.begin() + 1, dest.end(), dest.begin());
+        };
+
+        BENCHMARK("mfill " + desc)
+        {
+            return mfill(dest.begin(), dest.end(), value);
+        };
+    }
+}
+
+TEST_CASE("mcopy family - benchmarks", "[.][benchmark]")
+{
+    benchmark_copy_family("int", 42);
+    benchmark_copy_family("Point", Point{1, 2});
+    benchmark_copy_family("string", "text"s);
 }
\ No newline at end of file
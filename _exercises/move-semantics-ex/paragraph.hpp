@@ -1,66 +1,254 @@
 #ifndef PARAGRAPH_HPP_
 #define PARAGRAPH_HPP_
 
+#include "piece_table.hpp"
+#include "poly_vector.hpp"
+#include "render_target.hpp"
+
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace LegacyCode
 {
-    // TODO - implement move semantics for Paragraph
+    namespace ver_1_0
+    {
+        // previous layout: fixed 1 KB buffer on the heap for every text
+        class Paragraph
+        {
+            char* buffer_;
+
+        protected:
+            void swap(Paragraph& p)
+            {
+                std::swap(buffer_, p.buffer_);
+            }
+
+        public:
+            Paragraph()
+                : buffer_(new char[1024])
+            {
+                std::strcpy(buffer_, "Default text!");
+            }
+
+            Paragraph(const char* txt)
+                : buffer_(new char[1024])
+            {
+                std::strcpy(buffer_, txt);
+            }
+
+            // copy constructor
+            Paragraph(const Paragraph& p)
+                : buffer_(new char[1024])
+            {
+                std::strcpy(buffer_, p.buffer_);
+            }
+
+            // copy assignment op
+            Paragraph& operator=(const Paragraph& p)
+            {
+                Paragraph temp(p);
+                swap(temp);
+
+                return *this;
+            }
+
+            Paragraph(Paragraph&& source)
+                : buffer_{std::exchange(source.buffer_, nullptr)}
+            { }
+
+            Paragraph& operator=(Paragraph&& source)
+            {
+                if (this != &source)
+                {
+                    delete[] buffer_;
+
+                    buffer_ = std::exchange(source.buffer_, nullptr);
+                }
+
+                return *this;
+            }
+
+            void set_paragraph(const char* txt)
+            {
+                std::strcpy(buffer_, txt);
+            }
+
+            const char* get_paragraph() const
+            {
+                return buffer_;
+            }
+
+            void render_at(int posx, int posy) const
+            {
+                std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]" << std::endl;
+            }
+
+            virtual ~Paragraph()
+            {
+                delete[] buffer_;
+            }
+        };
+    } // namespace ver_1_0
+
+    // text is stored at its exact length - short texts live inside of the object (no heap allocation),
+    // longer ones in a heap buffer that grows when set_paragraph() needs more space
+    // insert() & erase() switch the paragraph to a piece table - small edits of a long text do not copy it
     class Paragraph
     {
-        char* buffer_;
+        static constexpr size_t inline_capacity = 15;
+
+        char* data_; // nullptr in a moved-from paragraph
+        size_t size_ = 0;
+        union
+        {
+            size_t capacity_;                  // when data_ points to the heap
+            char inline_[inline_capacity + 1]; // when data_ == inline_
+        };
+        std::unique_ptr<PieceTable> edits_; // when not null it holds the text - data_ is empty
+
+        // the first edit moves the text to a piece table - the old buffer is released after the edit,
+        // so an inserted text may point into it
+        template <typename TEdit>
+        void edit(TEdit edit_text)
+        {
+            if (edits_)
+            {
+                edit_text(*edits_);
+                return;
+            }
+
+            auto edits = std::make_unique<PieceTable>(std::string{view()});
+            edit_text(*edits);
+
+            edits_ = std::move(edits);
+            release();
+            data_ = inline_;
+            size_ = 0;
+            inline_[0] = '\0';
+        }
+
+        bool is_inline() const
+        {
+            return data_ == inline_;
+        }
+
+        void release()
+        {
+            if (data_ && !is_inline())
+                delete[] data_;
+        }
+
+        // txt may point into this paragraph
+        void assign(std::string_view txt)
+        {
+            if (data_ && txt.size() <= capacity())
+            {
+                std::memmove(data_, txt.data(), txt.size());
+            }
+            else
+            {
+                char* new_data = txt.size() <= inline_capacity ? inline_ : new char[txt.size() + 1];
+                std::memcpy(new_data, txt.data(), txt.size());
+                release();
+                data_ = new_data;
+                if (!is_inline())
+                    capacity_ = txt.size();
+            }
+
+            size_ = txt.size();
+            data_[size_] = '\0';
+        }
+
+        void take_from(Paragraph& source)
+        {
+            if (source.is_inline())
+            {
+                std::memcpy(inline_, source.inline_, sizeof(inline_));
+                data_ = inline_;
+            }
+            else
+            {
+                data_ = source.data_;
+                capacity_ = source.capacity_;
+            }
+            size_ = source.size_;
+            edits_ = std::move(source.edits_);
+
+            source.data_ = nullptr;
+            source.size_ = 0;
+        }
 
     protected:
         void swap(Paragraph& p)
         {
-            std::swap(buffer_, p.buffer_);
+            Paragraph temp(std::move(p));
+            p = std::move(*this);
+            *this = std::move(temp);
         }
 
     public:
         Paragraph()
-            : buffer_(new char[1024])
+            : Paragraph("Default text!")
         {
-            std::strcpy(buffer_, "Default text!");
         }
 
         Paragraph(const char* txt)
-            : buffer_(new char[1024])
+            : Paragraph(std::string_view{txt})
         {
-            std::strcpy(buffer_, txt);
+        }
+
+        explicit Paragraph(std::string_view txt)
+            : data_{nullptr}
+        {
+            assign(txt);
         }
 
         // copy constructor
         Paragraph(const Paragraph& p)
-            : buffer_(new char[1024])
+            : data_{nullptr}
         {
-            std::strcpy(buffer_, p.buffer_);
+            if (p.data_)
+                assign(p.view());
         }
 
-        // copy assignment op
+        // copy assignment op - reuses the buffer when the text fits
         Paragraph& operator=(const Paragraph& p)
         {
-            Paragraph temp(p);
-            swap(temp);
+            if (this != &p)
+            {
+                if (p.data_)
+                {
+                    assign(p.view());
+                }
+                else
+                {
+                    release();
+                    data_ = nullptr;
+                    size_ = 0;
+                }
+                edits_.reset();
+            }
 
             return *this;
         }
 
-        Paragraph(Paragraph&& source)
-            : buffer_{std::exchange(source.buffer_, nullptr)}
-        { }
+        Paragraph(Paragraph&& source) noexcept
+        {
+            take_from(source);
+        }
 
-        Paragraph& operator=(Paragraph&& source)
+        Paragraph& operator=(Paragraph&& source) noexcept
         {
             if (this != &source)
             {
-                delete[] buffer_;
-
-                buffer_ = std::exchange(source.buffer_, nullptr);
+                release();
+                take_from(source);
             }
 
             return *this;
@@ -68,22 +256,72 @@ namespace LegacyCode
 
         void set_paragraph(const char* txt)
         {
-            std::strcpy(buffer_, txt);
+            set_paragraph(std::string_view{txt});
+        }
+
+        // replaces the whole text - ends editing with a piece table
+        void set_paragraph(std::string_view txt)
+        {
+            assign(txt); // txt may point into the edited text
+            edits_.reset();
+        }
+
+        void insert(size_t pos, std::string_view txt)
+        {
+            edit([&](PieceTable& edits) { edits.insert(pos, txt); });
+        }
+
+        void erase(size_t pos, size_t count)
+        {
+            edit([&](PieceTable& edits) { edits.erase(pos, count); });
+        }
+
+        // calls f(std::string_view) for consecutive chunks of the text - no contiguous copy is built
+        template <typename TFunction>
+        void for_each_chunk(TFunction f) const
+        {
+            if (edits_)
+                edits_->for_each_chunk(f);
+            else if (size_)
+                f(view());
         }
 
+        // zero-terminated - nullptr in a moved-from paragraph
+        // an edited text is made contiguous on the first call after an edit
         const char* get_paragraph() const
         {
-            return buffer_;
+            return edits_ ? edits_->c_str() : data_;
+        }
+
+        std::string_view view() const
+        {
+            return edits_ ? edits_->view() : std::string_view{data_, size_};
         }
 
+        size_t size() const
+        {
+            return edits_ ? edits_->size() : size_;
+        }
+
+        size_t capacity() const
+        {
+            return is_inline() ? inline_capacity : (data_ ? capacity_ : 0);
+        }
+
+        // '\n' instead of std::endl - the stream is not flushed after every text
         void render_at(int posx, int posy) const
         {
-            std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]" << std::endl;
+            std::cout << "Rendering text '" << view() << "' at: [" << posx << ", " << posy << "]\n";
+        }
+
+        void render_at(RenderBuffer& out, int posx, int posy) const
+        {
+            out << "Rendering text '" << view() << "' at: [" << posx << ", " << posy << "]\n";
         }
 
         virtual ~Paragraph()
         {
-            delete[] buffer_;
+            release();
         }
     };
 } // namespace LegacyCode
@@ -93,6 +331,10 @@ class Shape
 public:
     virtual ~Shape() = default;
     virtual void draw() const = 0;
+
+    // formats the shape into out - RenderPipeline calls it concurrently for different shapes,
+    // so it must not write anywhere else
+    virtual void draw(RenderBuffer& out) const = 0;
 };
 
 // TODO - ensure that Text is copyable & moveable type
@@ -105,7 +347,7 @@ public:
     Text(int x, int y, const std::string& text)
         : x_{x}
         , y_{y}
-        , p_{text.c_str()}
+        , p_{text}
     {
     }
 
@@ -114,6 +356,11 @@ public:
         p_.render_at(x_, y_);
     }
 
+    void draw(RenderBuffer& out) const override
+    {
+        p_.render_at(out, x_, y_);
+    }
+
     std::string text() const
     {
         const char* txt = p_.get_paragraph();
@@ -122,26 +369,51 @@ public:
 
     void set_text(const std::string& text)
     {
-        p_.set_paragraph(text.c_str());
+        p_.set_paragraph(text);
+    }
+
+    void insert_text(size_t pos, std::string_view text)
+    {
+        p_.insert(pos, text);
+    }
+
+    void erase_text(size_t pos, size_t count)
+    {
+        p_.erase(pos, count);
     }
 };
 
+// shapes are stored in a contiguous arena - shapes[i] is a handle (pointer-like) to the i-th shape
 struct ShapeGroup : public Shape
 {
-    std::vector<std::unique_ptr<Shape>> shapes;
+    poly_vector<Shape> shapes;
 
     ShapeGroup() = default;
 
     void draw() const override
     {
         for (const auto& s : shapes)
-            s->draw();
+            s.draw();
     }
 
-    // TODO - implement adding a shape to a shapes container
+    void draw(RenderBuffer& out) const override
+    {
+        for (const auto& s : shapes)
+            s.draw(out);
+    }
+
+    // the shape is adopted - it stays in its own heap allocation
     void add(std::unique_ptr<Shape> shp)
     {
-        shapes.push_back(std::move(shp));
+        shapes.adopt(std::move(shp));
+    }
+
+    // the shape is constructed in the arena of the group - the handle stays valid while the group lives,
+    // also when the group is moved (e.g. by growth of the arena of an outer group)
+    template <typename TShape, typename... TArgs>
+    poly_vector<Shape>::handle emplace(TArgs&&... args)
+    {
+        return shapes.emplace_back<TShape>(std::forward<TArgs>(args)...);
     }
 };
 
@@ -0,0 +1,175 @@
+#ifndef PIECE_TABLE_HPP_
+#define PIECE_TABLE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Piece table - the text is a sequence of pieces referring to two buffers:
+//  * original - the text before editing (never modified)
+//  * added - append-only buffer with all inserted texts
+// An edit touches only the list of pieces - its cost depends on the number of edits, not on the length of the text.
+// The contiguous text is built on demand (c_str) and cached until the next edit.
+class PieceTable
+{
+    enum class Source : unsigned char
+    {
+        original,
+        added
+    };
+
+    struct Piece
+    {
+        Source source;
+        size_t start;
+        size_t length;
+    };
+
+    std::string original_;
+    std::string added_;
+    std::vector<Piece> pieces_;
+    size_t size_ = 0;
+
+    mutable std::string text_cache_;
+    mutable bool is_cache_valid_ = false;
+
+    std::string_view text_of(const Piece& piece) const
+    {
+        const std::string& buffer = piece.source == Source::original ? original_ : added_;
+        return std::string_view{buffer}.substr(piece.start, piece.length);
+    }
+
+    // makes a piece boundary at pos - returns the index of the first piece starting at pos
+    size_t split_at(size_t pos)
+    {
+        size_t offset = 0;
+        for (size_t i = 0; i < pieces_.size(); ++i)
+        {
+            if (pos == offset)
+                return i;
+
+            Piece& piece = pieces_[i];
+            if (pos < offset + piece.length)
+            {
+                const size_t left_length = pos - offset;
+                const Piece right{piece.source, piece.start + left_length, piece.length - left_length};
+                piece.length = left_length;
+                pieces_.insert(pieces_.begin() + i + 1, right);
+                return i + 1;
+            }
+
+            offset += piece.length;
+        }
+
+        return pieces_.size();
+    }
+
+    bool points_into_added(std::string_view text) const
+    {
+        const auto* first = added_.data();
+        const auto* last = added_.data() + added_.size();
+        return std::less_equal<>{}(first, text.data()) && std::less<>{}(text.data(), last);
+    }
+
+public:
+    PieceTable() = default;
+
+    explicit PieceTable(std::string original)
+        : original_{std::move(original)}
+        , size_{original_.size()}
+    {
+        if (size_)
+            pieces_.push_back(Piece{Source::original, 0, size_});
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    size_t pieces_count() const
+    {
+        return pieces_.size();
+    }
+
+    void insert(size_t pos, std::string_view text)
+    {
+        if (pos > size_)
+            throw std::out_of_range("PieceTable::insert - position out of range");
+
+        if (text.empty())
+            return;
+
+        if (points_into_added(text)) // appending may reallocate the added buffer
+        {
+            std::string copy{text};
+            insert(pos, copy);
+            return;
+        }
+
+        const size_t start = added_.size();
+        added_.append(text);
+
+        const size_t index = split_at(pos);
+        Piece* previous = index > 0 ? &pieces_[index - 1] : nullptr;
+        if (previous && previous->source == Source::added && previous->start + previous->length == start)
+            previous->length += text.size(); // typing - extends the previous insert
+        else
+            pieces_.insert(pieces_.begin() + index, Piece{Source::added, start, text.size()});
+
+        size_ += text.size();
+        is_cache_valid_ = false;
+    }
+
+    // count is clipped to the end of the text (as in std::string::erase)
+    void erase(size_t pos, size_t count)
+    {
+        if (pos > size_)
+            throw std::out_of_range("PieceTable::erase - position out of range");
+
+        count = std::min(count, size_ - pos);
+        if (count == 0)
+            return;
+
+        const size_t first = split_at(pos);
+        const size_t last = split_at(pos + count);
+        pieces_.erase(pieces_.begin() + first, pieces_.begin() + last);
+
+        size_ -= count;
+        is_cache_valid_ = false;
+    }
+
+    // calls f(std::string_view) for consecutive chunks of the text - no copying
+    template <typename TFunction>
+    void for_each_chunk(TFunction f) const
+    {
+        for (const Piece& piece : pieces_)
+            f(text_of(piece));
+    }
+
+    // zero-terminated contiguous text - valid until the next edit
+    const char* c_str() const
+    {
+        if (!is_cache_valid_)
+        {
+            text_cache_.clear();
+            text_cache_.reserve(size_);
+            for_each_chunk([this](std::string_view chunk) { text_cache_.append(chunk); });
+            is_cache_valid_ = true;
+        }
+
+        return text_cache_.c_str();
+    }
+
+    std::string_view view() const
+    {
+        return {c_str(), size_};
+    }
+};
+
+#endif /*PIECE_TABLE_HPP_*/
@@ -0,0 +1,369 @@
+#ifndef POLY_VECTOR_HPP_
+#define POLY_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// sequence of objects derived from TBase stored one after another in a single contiguous arena:
+//  * no heap allocation per object & iteration walks memory forward (prefetch friendly)
+//  * when the arena grows objects are moved to the new one - references are invalidated,
+//    handles (entry table + index) stay valid
+//  * the entry table is allocated on the heap & moved with the objects - handles survive also a move
+//    of the poly_vector (e.g. a poly_vector nested in an object of an arena that grows)
+//  * adopt(std::unique_ptr<TBase>) keeps an object created elsewhere in its own allocation
+//    (its dynamic type is unknown, so it cannot be moved into the arena)
+template <typename TBase>
+class poly_vector
+{
+    static_assert(std::has_virtual_destructor_v<TBase>);
+
+    static constexpr size_t arena_alignment = alignof(std::max_align_t);
+
+    struct Operations
+    {
+        void (*relocate)(void* source, void* target) noexcept; // move-constructs at target & destroys source
+        void (*destroy)(void* object) noexcept;
+        TBase* (*as_base)(void* object) noexcept;
+    };
+
+    template <typename T>
+    static void relocate(void* source, void* target) noexcept
+    {
+        ::new (target) T(std::move(*static_cast<T*>(source)));
+        static_cast<T*>(source)->~T();
+    }
+
+    template <typename T>
+    static void destroy(void* object) noexcept
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    template <typename T>
+    static TBase* as_base(void* object) noexcept
+    {
+        return static_cast<T*>(object);
+    }
+
+    using Adopted = std::unique_ptr<TBase>;
+
+    static TBase* adopted_as_base(void* object) noexcept
+    {
+        return static_cast<Adopted*>(object)->get();
+    }
+
+    template <typename T>
+    static constexpr Operations operations_for{&relocate<T>, &destroy<T>, &as_base<T>};
+
+    static constexpr Operations adopted_operations{&relocate<Adopted>, &destroy<Adopted>, &adopted_as_base};
+
+    struct Entry
+    {
+        TBase* object;
+        size_t offset;
+        const Operations* operations;
+    };
+
+    using Entries = std::vector<Entry>;
+
+    static inline Entries no_entries_{}; // shared by all poly_vectors without a table - never modified
+
+    std::byte* arena_ = nullptr;
+    size_t arena_size_ = 0; // used bytes
+    size_t arena_capacity_ = 0;
+    std::unique_ptr<Entries> entries_; // created by the first insertion - null in a moved-from poly_vector
+
+    Entries& entries() const
+    {
+        return entries_ ? *entries_ : no_entries_;
+    }
+
+    Entries& entries_to_insert()
+    {
+        if (!entries_)
+            entries_ = std::make_unique<Entries>();
+        return *entries_;
+    }
+
+    static std::byte* allocate_arena(size_t capacity)
+    {
+        return static_cast<std::byte*>(::operator new(capacity, std::align_val_t{arena_alignment}));
+    }
+
+    static void deallocate_arena(std::byte* arena)
+    {
+        if (arena)
+            ::operator delete(arena, std::align_val_t{arena_alignment});
+    }
+
+    // returns an offset of a free, aligned block - grows the arena if needed
+    size_t reserve_block(size_t size, size_t alignment)
+    {
+        const size_t offset = (arena_size_ + alignment - 1) / alignment * alignment;
+        if (offset + size > arena_capacity_)
+            grow(offset + size);
+
+        arena_size_ = offset + size;
+        return offset;
+    }
+
+    void grow(size_t required)
+    {
+        size_t new_capacity = std::max<size_t>(arena_capacity_ ? 2 * arena_capacity_ : 256, required);
+        std::byte* new_arena = allocate_arena(new_capacity);
+
+        for (Entry& entry : entries())
+        {
+            entry.operations->relocate(arena_ + entry.offset, new_arena + entry.offset);
+            entry.object = entry.operations->as_base(new_arena + entry.offset);
+        }
+
+        deallocate_arena(std::exchange(arena_, new_arena));
+        arena_capacity_ = new_capacity;
+    }
+
+    template <typename T, typename... TArgs>
+    size_t emplace_entry(const Operations& operations, TArgs&&... args)
+    {
+        static_assert(alignof(T) <= arena_alignment);
+        static_assert(std::is_nothrow_move_constructible_v<T>, "objects are moved when the arena grows");
+
+        Entries& entries = entries_to_insert();
+        if (entries.size() == entries.capacity()) // no throw after the object is constructed
+            entries.reserve(std::max<size_t>(8, 2 * entries.capacity()));
+
+        const size_t previous_size = arena_size_;
+        const size_t offset = reserve_block(sizeof(T), alignof(T));
+        try
+        {
+            ::new (arena_ + offset) T(std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            arena_size_ = previous_size;
+            throw;
+        }
+
+        entries.push_back(Entry{operations.as_base(arena_ + offset), offset, &operations});
+        return entries.size() - 1;
+    }
+
+public:
+    template <bool IsConst>
+    class Iterator
+    {
+        using EntryIterator = std::conditional_t<IsConst, typename Entries::const_iterator, typename Entries::iterator>;
+
+        EntryIterator it_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TBase;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const TBase*, TBase*>;
+        using reference = std::conditional_t<IsConst, const TBase&, TBase&>;
+
+        Iterator() = default;
+
+        explicit Iterator(EntryIterator it)
+            : it_{it}
+        { }
+
+        reference operator*() const
+        {
+            return *it_->object;
+        }
+
+        pointer operator->() const
+        {
+            return it_->object;
+        }
+
+        Iterator& operator++()
+        {
+            ++it_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            return Iterator{it_++};
+        }
+
+        bool operator==(const Iterator&) const = default;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // pointer-like access to an object that survives growth of the arena & a move of the poly_vector
+    template <bool IsConst>
+    class Handle
+    {
+        friend class poly_vector;
+
+        using Pointer = std::conditional_t<IsConst, const TBase*, TBase*>;
+
+        const Entries* entries_ = nullptr;
+        size_t index_ = 0;
+
+        Handle(const Entries& entries, size_t index)
+            : entries_{&entries}
+            , index_{index}
+        { }
+
+    public:
+        Handle() = default;
+
+        Pointer get() const
+        {
+            return (*entries_)[index_].object;
+        }
+
+        auto& operator*() const
+        {
+            return *get();
+        }
+
+        Pointer operator->() const
+        {
+            return get();
+        }
+
+        size_t index() const
+        {
+            return index_;
+        }
+    };
+
+    using handle = Handle<false>;
+    using const_handle = Handle<true>;
+
+    poly_vector() = default;
+    poly_vector(const poly_vector&) = delete;
+    poly_vector& operator=(const poly_vector&) = delete;
+
+    poly_vector(poly_vector&& other) noexcept
+        : arena_{std::exchange(other.arena_, nullptr)}
+        , arena_size_{std::exchange(other.arena_size_, 0)}
+        , arena_capacity_{std::exchange(other.arena_capacity_, 0)}
+        , entries_{std::move(other.entries_)}
+    { }
+
+    poly_vector& operator=(poly_vector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            deallocate_arena(arena_);
+
+            arena_ = std::exchange(other.arena_, nullptr);
+            arena_size_ = std::exchange(other.arena_size_, 0);
+            arena_capacity_ = std::exchange(other.arena_capacity_, 0);
+            entries_ = std::move(other.entries_);
+        }
+
+        return *this;
+    }
+
+    ~poly_vector()
+    {
+        clear();
+        deallocate_arena(arena_);
+    }
+
+    size_t size() const
+    {
+        return entries().size();
+    }
+
+    bool empty() const
+    {
+        return entries().empty();
+    }
+
+    // bytes of the arena in use
+    size_t arena_size() const
+    {
+        return arena_size_;
+    }
+
+    void reserve(size_t count, size_t arena_bytes)
+    {
+        entries_to_insert().reserve(count);
+        if (arena_bytes > arena_capacity_)
+            grow(arena_bytes);
+    }
+
+    // args must not refer to objects of this poly_vector - they may be moved by growth of the arena
+    template <typename T, typename... TArgs>
+        requires std::is_base_of_v<TBase, T>
+    handle emplace_back(TArgs&&... args)
+    {
+        const size_t index = emplace_entry<T>(operations_for<T>, std::forward<TArgs>(args)...);
+        return handle{*entries_, index};
+    }
+
+    template <typename T>
+        requires std::is_base_of_v<TBase, std::remove_cvref_t<T>>
+    handle push_back(T&& object)
+    {
+        return emplace_back<std::remove_cvref_t<T>>(std::forward<T>(object));
+    }
+
+    handle adopt(std::unique_ptr<TBase> object)
+    {
+        const size_t index = emplace_entry<Adopted>(adopted_operations, std::move(object));
+        return handle{*entries_, index};
+    }
+
+    handle operator[](size_t index)
+    {
+        return handle{entries(), index};
+    }
+
+    const_handle operator[](size_t index) const
+    {
+        return const_handle{entries(), index};
+    }
+
+    void clear() noexcept
+    {
+        if (entries_)
+        {
+            for (auto it = entries_->rbegin(); it != entries_->rend(); ++it)
+                it->operations->destroy(arena_ + it->offset);
+
+            entries_->clear();
+        }
+        arena_size_ = 0;
+    }
+
+    iterator begin()
+    {
+        return iterator{entries().begin()};
+    }
+
+    iterator end()
+    {
+        return iterator{entries().end()};
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{entries().begin()};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{entries().end()};
+    }
+};
+
+#endif /*POLY_VECTOR_HPP_*/
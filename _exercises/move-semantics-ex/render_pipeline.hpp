@@ -0,0 +1,85 @@
+#ifndef RENDER_PIPELINE_HPP_
+#define RENDER_PIPELINE_HPP_
+
+#include "paragraph.hpp"
+#include "poly_vector.hpp"
+#include "render_target.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// draws a frame of shapes into per-thread buffers & writes it to a target with one vectored write:
+//  * shapes are split into contiguous ranges - one range (and one buffer) per thread
+//  * buffers are written in the order of ranges - the output is the same as for sequential drawing
+//  * buffers keep their capacity - after the first frame formatting does not allocate
+// a pipeline with one thread draws sequentially on the calling thread
+class RenderPipeline
+{
+    std::vector<RenderBuffer> buffers_;
+
+public:
+    explicit RenderPipeline(size_t threads_count = std::max(1u, std::thread::hardware_concurrency()))
+        : buffers_(std::max<size_t>(1, threads_count))
+    { }
+
+    size_t threads_count() const
+    {
+        return buffers_.size();
+    }
+
+    void render(const poly_vector<Shape>& shapes, RenderTarget& target)
+    {
+        const size_t ranges_count = std::clamp<size_t>(shapes.size(), 1, buffers_.size());
+        std::vector<std::exception_ptr> errors(ranges_count);
+
+        auto draw_range = [&](size_t index) {
+            try
+            {
+                RenderBuffer& buffer = buffers_[index];
+                buffer.clear();
+
+                const size_t first = shapes.size() * index / ranges_count;
+                const size_t last = shapes.size() * (index + 1) / ranges_count;
+                for (size_t i = first; i < last; ++i)
+                    shapes[i]->draw(buffer);
+            }
+            catch (...)
+            {
+                errors[index] = std::current_exception();
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(ranges_count - 1);
+            for (size_t index = 1; index < ranges_count; ++index)
+                workers.emplace_back(draw_range, index);
+
+            draw_range(0); // the calling thread draws the first range
+        }
+
+        for (const std::exception_ptr& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        std::vector<std::string_view> chunks;
+        chunks.reserve(ranges_count);
+        for (size_t index = 0; index < ranges_count; ++index)
+            chunks.push_back(buffers_[index].view());
+
+        target.write(chunks);
+    }
+
+    void render(const ShapeGroup& group, RenderTarget& target)
+    {
+        render(group.shapes, target);
+    }
+};
+
+#endif /*RENDER_PIPELINE_HPP_*/
@@ -0,0 +1,161 @@
+#ifndef RENDER_TARGET_HPP_
+#define RENDER_TARGET_HPP_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// text of rendered shapes collected in memory - nothing is written (or flushed) until
+// the buffer is handed over to a RenderTarget
+class RenderBuffer
+{
+    std::string text_;
+
+public:
+    RenderBuffer& operator<<(std::string_view text)
+    {
+        text_.append(text);
+        return *this;
+    }
+
+    RenderBuffer& operator<<(char c)
+    {
+        text_.push_back(c);
+        return *this;
+    }
+
+    RenderBuffer& operator<<(int value)
+    {
+        char digits[16];
+        const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+        text_.append(digits, result.ptr);
+        return *this;
+    }
+
+    std::string_view view() const
+    {
+        return text_;
+    }
+
+    size_t size() const
+    {
+        return text_.size();
+    }
+
+    void reserve(size_t capacity)
+    {
+        text_.reserve(capacity);
+    }
+
+    // keeps the capacity - a buffer is reused frame after frame
+    void clear()
+    {
+        text_.clear();
+    }
+};
+
+// destination of rendered text - chunks are written in order, as if they were one text
+class RenderTarget
+{
+public:
+    virtual ~RenderTarget() = default;
+    virtual void write(std::span<const std::string_view> chunks) = 0;
+
+    void write(std::string_view text)
+    {
+        write(std::span{&text, 1});
+    }
+};
+
+class OstreamTarget : public RenderTarget
+{
+    std::ostream& out_;
+
+public:
+    explicit OstreamTarget(std::ostream& out)
+        : out_{out}
+    { }
+
+    void write(std::span<const std::string_view> chunks) override
+    {
+        for (std::string_view chunk : chunks)
+            out_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    }
+
+    using RenderTarget::write;
+};
+
+// POSIX file written with vectored writes - all chunks go to the kernel in one writev() call
+// (or in a few calls when there are more than IOV_MAX chunks or the write is partial)
+class FileTarget : public RenderTarget
+{
+    int fd_;
+
+public:
+    explicit FileTarget(const std::string& path)
+        : fd_{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)}
+    {
+        if (fd_ == -1)
+            throw std::system_error(errno, std::generic_category(), "FileTarget - cannot open " + path);
+    }
+
+    FileTarget(const FileTarget&) = delete;
+    FileTarget& operator=(const FileTarget&) = delete;
+
+    ~FileTarget() override
+    {
+        ::close(fd_);
+    }
+
+    void write(std::span<const std::string_view> chunks) override
+    {
+        std::vector<iovec> iovs;
+        iovs.reserve(chunks.size());
+        for (std::string_view chunk : chunks)
+        {
+            if (!chunk.empty())
+                iovs.push_back(iovec{const_cast<char*>(chunk.data()), chunk.size()});
+        }
+
+        iovec* first = iovs.data();
+        iovec* last = iovs.data() + iovs.size();
+        while (first != last)
+        {
+            const int count = static_cast<int>(std::min<ptrdiff_t>(last - first, IOV_MAX));
+            ssize_t written = ::writev(fd_, first, count);
+            if (written == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "FileTarget - write failed");
+            }
+
+            // skips fully written chunks & moves the start of a partially written one
+            for (; first != last && static_cast<size_t>(written) >= first->iov_len; ++first)
+                written -= static_cast<ssize_t>(first->iov_len);
+
+            if (first != last)
+            {
+                first->iov_base = static_cast<char*>(first->iov_base) + written;
+                first->iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+
+    using RenderTarget::write;
+};
+
+#endif /*RENDER_TARGET_HPP_*/
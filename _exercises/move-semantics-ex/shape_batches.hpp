@@ -0,0 +1,198 @@
+#ifndef SHAPE_BATCHES_HPP_
+#define SHAPE_BATCHES_HPP_
+
+#include "paragraph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// shapes of one concrete type drawn in a tight loop - a qualified call TShape::draw()
+// skips the virtual dispatch and can be inlined
+// draw(first, count) draws to std::cout, draw(first, count, out) formats into a RenderBuffer
+// specialize ShapeBatch to keep a type as a structure of arrays
+template <typename TShape>
+class ShapeBatch
+{
+    std::vector<TShape> shapes_;
+
+public:
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        shapes_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    size_t size() const
+    {
+        return shapes_.size();
+    }
+
+    template <typename... TOut>
+    void draw(size_t first, size_t count, TOut&... out) const
+    {
+        for (size_t i = first; i < first + count; ++i)
+            shapes_[i].TShape::draw(out...);
+    }
+};
+
+// Text as a structure of arrays - positions & paragraphs are stored (and walked) separately
+template <>
+class ShapeBatch<Text>
+{
+    std::vector<int> xs_;
+    std::vector<int> ys_;
+    std::vector<LegacyCode::Paragraph> paragraphs_;
+
+    template <typename TItem>
+    static void reserve_one_more(std::vector<TItem>& items)
+    {
+        if (items.size() == items.capacity())
+            items.reserve(std::max<size_t>(8, 2 * items.capacity()));
+    }
+
+public:
+    // all vectors have room before anything is appended - if the paragraph throws they stay the same size
+    void emplace(int x, int y, std::string_view text)
+    {
+        reserve_one_more(xs_);
+        reserve_one_more(ys_);
+        reserve_one_more(paragraphs_);
+
+        paragraphs_.emplace_back(text);
+        xs_.push_back(x);
+        ys_.push_back(y);
+    }
+
+    size_t size() const
+    {
+        return paragraphs_.size();
+    }
+
+    template <typename... TOut>
+    void draw(size_t first, size_t count, TOut&... out) const
+    {
+        for (size_t i = first; i < first + count; ++i)
+            paragraphs_[i].render_at(out..., xs_[i], ys_[i]);
+    }
+};
+
+enum class DrawOrder
+{
+    by_type, // all shapes of the first type, then the second type...
+    z_order  // insertion order - consecutive shapes of the same type are still drawn as a batch
+};
+
+// data-oriented alternative to ShapeGroup for a closed set of shape types:
+// shapes are bucketed by their concrete type instead of being stored behind pointers to Shape
+template <typename... TShapes>
+class ShapeBatches : public Shape
+{
+    static_assert(sizeof...(TShapes) > 0 && sizeof...(TShapes) <= 256);
+
+    template <typename TShape>
+    static constexpr size_t index_of = []<size_t... Is>(std::index_sequence<Is...>) {
+        size_t index = sizeof...(TShapes);
+        ((std::is_same_v<TShape, TShapes> ? (index = Is) : 0), ...);
+        return index;
+    }(std::index_sequence_for<TShapes...>{});
+
+    // consecutive shapes of the same type in insertion order
+    struct Run
+    {
+        uint8_t batch;
+        size_t first;
+        size_t count;
+    };
+
+    std::tuple<ShapeBatch<TShapes>...> batches_;
+    std::vector<Run> runs_;
+    DrawOrder order_;
+
+    template <size_t Index, typename... TOut>
+    static void draw_run(const ShapeBatches& self, size_t first, size_t count, TOut&... out)
+    {
+        std::get<Index>(self.batches_).draw(first, count, out...);
+    }
+
+    template <typename... TOut>
+    static constexpr auto run_drawers = []<size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<void (*)(const ShapeBatches&, size_t, size_t, TOut&...), sizeof...(Is)>{&draw_run<Is, TOut...>...};
+    }(std::index_sequence_for<TShapes...>{});
+
+    // no out - draws to std::cout
+    template <typename... TOut>
+    void draw_in(DrawOrder order, TOut&... out) const
+    {
+        if (order == DrawOrder::by_type)
+        {
+            std::apply([&](const auto&... batches) { (batches.draw(0, batches.size(), out...), ...); }, batches_);
+        }
+        else
+        {
+            for (const Run& run : runs_)
+                run_drawers<TOut...>[run.batch](*this, run.first, run.count, out...);
+        }
+    }
+
+public:
+    explicit ShapeBatches(DrawOrder order = DrawOrder::by_type)
+        : order_{order}
+    { }
+
+    template <typename TShape, typename... TArgs>
+        requires(index_of<TShape> < sizeof...(TShapes))
+    void emplace(TArgs&&... args)
+    {
+        constexpr size_t index = index_of<TShape>;
+        auto& batch = std::get<index>(batches_);
+
+        if (runs_.size() == runs_.capacity()) // no throw after the shape is added
+            runs_.reserve(std::max<size_t>(8, 2 * runs_.capacity()));
+        batch.emplace(std::forward<TArgs>(args)...);
+
+        if (!runs_.empty() && runs_.back().batch == index)
+            ++runs_.back().count;
+        else
+            runs_.push_back(Run{static_cast<uint8_t>(index), batch.size() - 1, 1});
+    }
+
+    template <typename TShape>
+    size_t count() const
+    {
+        return std::get<index_of<TShape>>(batches_).size();
+    }
+
+    size_t size() const
+    {
+        return std::apply([](const auto&... batches) { return (batches.size() + ...); }, batches_);
+    }
+
+    void draw() const override
+    {
+        draw(order_);
+    }
+
+    void draw(DrawOrder order) const
+    {
+        draw_in(order);
+    }
+
+    void draw(RenderBuffer& out) const override
+    {
+        draw_in(order_, out);
+    }
+
+    void draw(RenderBuffer& out, DrawOrder order) const
+    {
+        draw_in(order, out);
+    }
+};
+
+#endif /*SHAPE_BATCHES_HPP_*/
@@ -1,9 +1,26 @@
 
 #include "paragraph.hpp"
+#include "render_pipeline.hpp"
+#include "shape_batches.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 using namespace std;
 
 TEST_CASE("Moving paragraph")
@@ -33,4 +50,894 @@ TEST_CASE("ShapeGroup")
 
     Text& t = dynamic_cast<Text&>(*sg.shapes[0]);
     REQUIRE(t.text() == "text"s);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Paragraph storage")
+{
+    SECTION("short text is stored inline")
+    {
+        LegacyCode::Paragraph p("label");
+
+        REQUIRE(p.view() == "label");
+        REQUIRE(p.size() == 5);
+        REQUIRE(p.capacity() == 15);
+        REQUIRE(reinterpret_cast<const char*>(&p) <= p.get_paragraph());
+        REQUIRE(p.get_paragraph() < reinterpret_cast<const char*>(&p) + sizeof(p));
+    }
+
+    SECTION("long text is stored at exact length")
+    {
+        std::string text(1'500, 'x'); // did not fit into the 1 KB buffer of ver_1_0
+
+        LegacyCode::Paragraph p(text.c_str());
+
+        REQUIRE(p.get_paragraph() == text);
+        REQUIRE(p.capacity() == 1'500);
+    }
+
+    SECTION("set_paragraph grows the buffer")
+    {
+        LegacyCode::Paragraph p("short");
+        std::string text(100, 'y');
+
+        p.set_paragraph(text);
+        REQUIRE(p.view() == text);
+        REQUIRE(p.get_paragraph()[100] == '\0');
+
+        p.set_paragraph("short again");
+        REQUIRE(p.get_paragraph() == "short again"s);
+        REQUIRE(p.capacity() == 100);
+    }
+
+    SECTION("set_paragraph with a part of its own text")
+    {
+        LegacyCode::Paragraph p("a long text stored on the heap");
+
+        p.set_paragraph(p.view().substr(7));
+
+        REQUIRE(p.view() == "text stored on the heap");
+    }
+
+    SECTION("moving inline text")
+    {
+        LegacyCode::Paragraph p("abc");
+        LegacyCode::Paragraph target("a long text stored on the heap");
+
+        target = std::move(p);
+
+        REQUIRE(target.view() == "abc");
+        REQUIRE(p.get_paragraph() == nullptr);
+    }
+
+    SECTION("moved-from paragraph can be copied & assigned")
+    {
+        LegacyCode::Paragraph p("abc");
+        LegacyCode::Paragraph mp = std::move(p);
+
+        LegacyCode::Paragraph copy = p;
+        REQUIRE(copy.get_paragraph() == nullptr);
+
+        p.set_paragraph("new text");
+        REQUIRE(p.view() == "new text");
+    }
+}
+
+namespace
+{
+    // bytes in use on the heap (including malloc overhead) - 0 when unknown
+    size_t heap_in_use()
+    {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+        return mallinfo2().uordblks;
+#else
+        return 0;
+#endif
+    }
+} // namespace
+
+namespace ver_1_0
+{
+    // Text with the previous layout of a Paragraph
+    class Text : public Shape
+    {
+        int x_, y_;
+        LegacyCode::ver_1_0::Paragraph p_;
+
+    public:
+        Text(int x, int y, const std::string& text)
+            : x_{x}
+            , y_{y}
+            , p_{text.c_str()}
+        {
+        }
+
+        void draw() const override
+        {
+            p_.render_at(x_, y_);
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            out << "Rendering text '" << p_.get_paragraph() << "' at: [" << x_ << ", " << y_ << "]\n";
+        }
+    };
+} // namespace ver_1_0
+
+TEST_CASE("Text - memory footprint - benchmarks", "[.][benchmark]")
+{
+    constexpr int count = 1'000'000;
+
+    // mostly short labels, every 10th text is longer than the inline storage
+    auto make_label = [](int i) {
+        return i % 10 == 0 ? "a longer description of item " + std::to_string(i) : "item " + std::to_string(i);
+    };
+
+    auto run = [&]<typename TText>(const std::string& desc) {
+        {
+            std::vector<TText> texts;
+            texts.reserve(count);
+
+            const size_t heap_before = heap_in_use();
+            for (int i = 0; i < count; ++i)
+                texts.emplace_back(i, i, make_label(i));
+            const size_t heap_bytes = heap_in_use() - heap_before;
+
+            std::cout << "1M texts - " << desc << ": sizeof = " << sizeof(TText)
+                      << " B, heap = " << heap_bytes / (1024 * 1024) << " MB, total = "
+                      << (count * sizeof(TText) + heap_bytes) / (1024 * 1024) << " MB\n";
+        }
+
+        BENCHMARK("create 1M texts - " + desc)
+        {
+            std::vector<TText> texts;
+            texts.reserve(count);
+            for (int i = 0; i < count; ++i)
+                texts.emplace_back(i, i, make_label(i));
+            return texts.size();
+        };
+    };
+
+    run.operator()<ver_1_0::Text>("ver_1_0::Paragraph (1 KB buffer)");
+    run.operator()<Text>("Paragraph (exact size + inline storage)");
+}
+
+TEST_CASE("Editing paragraph")
+{
+    LegacyCode::Paragraph p("Hello world!");
+
+    SECTION("insert")
+    {
+        p.insert(5, ",");
+        p.insert(0, ">> ");
+        p.insert(p.size(), " <<");
+
+        REQUIRE(p.get_paragraph() == ">> Hello, world! <<"s);
+        REQUIRE(p.size() == 19);
+    }
+
+    SECTION("erase")
+    {
+        p.erase(5, 6);
+        REQUIRE(p.view() == "Hello!");
+
+        p.erase(4, 100); // clipped to the end
+        REQUIRE(p.view() == "Hell");
+    }
+
+    SECTION("erase across inserted pieces")
+    {
+        p.insert(6, "new ");
+        p.insert(0, "Oh, ");
+        p.erase(2, 12);
+
+        REQUIRE(p.view() == "Ohworld!");
+    }
+
+    SECTION("typing extends the last insert - text is iterated in chunks")
+    {
+        std::string_view typed = "beautiful ";
+        for (size_t i = 0; i < typed.size(); ++i)
+            p.insert(6 + i, typed.substr(i, 1));
+
+        std::vector<std::string> chunks;
+        p.for_each_chunk([&](std::string_view chunk) { chunks.emplace_back(chunk); });
+
+        REQUIRE(chunks == std::vector<std::string>{"Hello ", "beautiful ", "world!"});
+    }
+
+    SECTION("contiguous text is cached until the next edit")
+    {
+        p.insert(0, "!");
+        const char* text = p.get_paragraph();
+        REQUIRE(p.get_paragraph() == text);
+
+        p.insert(0, "!");
+        REQUIRE(p.get_paragraph() == "!!Hello world!"s);
+    }
+
+    SECTION("insert of its own text")
+    {
+        p.insert(0, p.view()); // inline text
+        REQUIRE(p.view() == "Hello world!Hello world!");
+
+        p.insert(12, p.view().substr(0, 6)); // edited text
+        REQUIRE(p.view() == "Hello world!Hello Hello world!");
+
+        LegacyCode::Paragraph long_p{"a text long enough to be stored on the heap"};
+        long_p.insert(long_p.size(), long_p.view());
+        REQUIRE(long_p.view() == "a text long enough to be stored on the heapa text long enough to be stored on the heap");
+    }
+
+    SECTION("edit out of range throws")
+    {
+        REQUIRE_THROWS_AS(p.insert(13, "x"), std::out_of_range);
+        REQUIRE_THROWS_AS(p.erase(13, 1), std::out_of_range);
+    }
+
+    SECTION("copy of an edited paragraph")
+    {
+        p.insert(5, ",");
+        LegacyCode::Paragraph copy = p;
+        p.erase(0, 7);
+
+        REQUIRE(copy.view() == "Hello, world!");
+        REQUIRE(p.view() == "world!");
+    }
+
+    SECTION("move of an edited paragraph")
+    {
+        p.insert(5, ",");
+        LegacyCode::Paragraph mp = std::move(p);
+
+        REQUIRE(mp.view() == "Hello, world!");
+        REQUIRE(p.get_paragraph() == nullptr);
+    }
+
+    SECTION("set_paragraph replaces an edited text")
+    {
+        p.insert(5, ",");
+        p.set_paragraph(p.view().substr(7));
+
+        REQUIRE(p.view() == "world!");
+
+        p.insert(0, "new ");
+        REQUIRE(p.view() == "new world!");
+    }
+
+    SECTION("Text edits")
+    {
+        Text txt{10, 20, "text"};
+        txt.insert_text(0, "long ");
+        txt.erase_text(4, 1);
+
+        REQUIRE(txt.text() == "longtext");
+    }
+}
+
+TEST_CASE("Editing text - benchmarks", "[.][benchmark]")
+{
+    struct Document
+    {
+        std::string desc;
+        size_t size;
+        int edits_count;
+    };
+
+    for (const auto& [desc, size, edits_count] : {Document{"1 MB", 1'000'000, 1'000}, Document{"100 MB", 100'000'000, 10}})
+    {
+        const std::string document(size, 'x');
+        const std::string edits_desc = std::to_string(edits_count) + " random edits - " + desc;
+
+        // every edit inserts or erases 4 characters at a random position
+        auto for_each_edit = [&](auto insert, auto erase) {
+            std::mt19937_64 rnd{665};
+            for (int i = 0; i < edits_count; ++i)
+            {
+                const size_t pos = rnd() % (document.size() - 4);
+                if (i % 2 == 0)
+                    insert(pos, std::string_view{"edit"});
+                else
+                    erase(pos, 4);
+            }
+        };
+
+        BENCHMARK("open & read (baseline) - " + desc)
+        {
+            Text text{0, 0, document};
+            return text.text().size();
+        };
+
+        BENCHMARK("set_text after every edit - " + edits_desc)
+        {
+            Text text{0, 0, document};
+            std::string edited = document;
+            for_each_edit(
+                [&](size_t pos, std::string_view txt) { edited.insert(pos, txt); text.set_text(edited); },
+                [&](size_t pos, size_t count) { edited.erase(pos, count); text.set_text(edited); });
+            return text.text().size();
+        };
+
+        BENCHMARK("insert_text & erase_text - " + edits_desc)
+        {
+            Text text{0, 0, document};
+            for_each_edit(
+                [&](size_t pos, std::string_view txt) { text.insert_text(pos, txt); },
+                [&](size_t pos, size_t count) { text.erase_text(pos, count); });
+            return text.text().size();
+        };
+    }
+}
+
+namespace
+{
+    long draw_sink = 0;
+
+    struct Dot : Shape
+    {
+        int x, y;
+
+        Dot(int x, int y)
+            : x{x}
+            , y{y}
+        { }
+
+        void draw() const override
+        {
+            draw_sink += x ^ y;
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            out << "Dot at: [" << x << ", " << y << "]\n";
+        }
+    };
+
+    struct Box : Shape
+    {
+        int x, y, width, height;
+
+        Box(int x, int y, int width, int height)
+            : x{x}
+            , y{y}
+            , width{width}
+            , height{height}
+        { }
+
+        void draw() const override
+        {
+            draw_sink += (x + width) * (y + height);
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            out << "Box at: [" << x << ", " << y << "] size: " << width << "x" << height << "\n";
+        }
+    };
+
+    struct Counted : Shape
+    {
+        static inline int alive_count = 0;
+
+        Counted()
+        {
+            ++alive_count;
+        }
+
+        Counted(Counted&&) noexcept
+        {
+            ++alive_count;
+        }
+
+        ~Counted() override
+        {
+            --alive_count;
+        }
+
+        void draw() const override
+        { }
+
+        void draw(RenderBuffer&) const override
+        { }
+    };
+} // namespace
+
+TEST_CASE("ShapeGroup - contiguous storage")
+{
+    ShapeGroup sg;
+
+    SECTION("shapes of different types in one arena")
+    {
+        sg.emplace<Text>(1, 2, "text");
+        sg.emplace<Dot>(3, 4);
+        auto nested = sg.emplace<ShapeGroup>();
+        dynamic_cast<ShapeGroup&>(*nested).emplace<Text>(5, 6, "nested text");
+
+        REQUIRE(sg.shapes.size() == 3);
+        REQUIRE(dynamic_cast<Text&>(*sg.shapes[0]).text() == "text");
+        REQUIRE(dynamic_cast<Dot&>(*sg.shapes[1]).y == 4);
+        REQUIRE(dynamic_cast<Text&>(*dynamic_cast<ShapeGroup&>(*sg.shapes[2]).shapes[0]).text() == "nested text");
+    }
+
+    SECTION("handles stay valid when the arena grows")
+    {
+        auto first = sg.emplace<Text>(1, 2, "first");
+        const Shape* address_before = first.get();
+
+        for (int i = 0; i < 1'000; ++i)
+            sg.emplace<Dot>(i, i);
+
+        REQUIRE(first.get() != address_before); // moved to a bigger arena
+        REQUIRE(dynamic_cast<Text&>(*first).text() == "first");
+    }
+
+    SECTION("handles into a nested group stay valid when the outer arena grows")
+    {
+        auto nested = sg.emplace<ShapeGroup>();
+        auto inner = dynamic_cast<ShapeGroup&>(*nested).emplace<Text>(1, 2, "inner");
+
+        for (int i = 0; i < 100; ++i)
+            sg.emplace<Dot>(i, i); // the nested group is moved to a bigger arena
+
+        REQUIRE(dynamic_cast<Text&>(*inner).text() == "inner");
+        REQUIRE(inner.get() == dynamic_cast<ShapeGroup&>(*nested).shapes[0].get());
+    }
+
+    SECTION("handles survive a move of the group")
+    {
+        auto text = sg.emplace<Text>(1, 2, "text");
+        ShapeGroup moved = std::move(sg);
+
+        REQUIRE(dynamic_cast<Text&>(*text).text() == "text");
+        REQUIRE(sg.shapes.empty());
+    }
+
+    SECTION("add adopts a shape created on the heap")
+    {
+        auto text = std::make_unique<Text>(1, 2, "adopted");
+        const Text* address = text.get();
+
+        sg.emplace<Dot>(0, 0);
+        sg.add(std::move(text));
+        for (int i = 0; i < 100; ++i)
+            sg.emplace<Dot>(i, i);
+
+        REQUIRE(sg.shapes[1].get() == address);
+    }
+
+    SECTION("iteration in insertion order")
+    {
+        for (int i = 0; i < 10; ++i)
+            sg.emplace<Dot>(i, 0);
+
+        int expected = 0;
+        for (const Shape& shape : sg.shapes)
+            REQUIRE(dynamic_cast<const Dot&>(shape).x == expected++);
+    }
+
+    SECTION("shapes are destroyed with the group")
+    {
+        {
+            ShapeGroup group;
+            for (int i = 0; i < 100; ++i)
+                group.emplace<Counted>();
+            group.add(std::make_unique<Counted>());
+
+            REQUIRE(Counted::alive_count == 101);
+
+            ShapeGroup moved = std::move(group);
+            REQUIRE(Counted::alive_count == 101);
+        }
+
+        REQUIRE(Counted::alive_count == 0);
+    }
+}
+
+namespace ver_1_0
+{
+    struct ShapeGroup : public Shape
+    {
+        std::vector<std::unique_ptr<Shape>> shapes;
+
+        void draw() const override
+        {
+            for (const auto& s : shapes)
+                s->draw();
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            for (const auto& s : shapes)
+                s->draw(out);
+        }
+
+        void add(std::unique_ptr<Shape> shp)
+        {
+            shapes.push_back(std::move(shp));
+        }
+    };
+} // namespace ver_1_0
+
+TEST_CASE("ShapeGroup - draw - benchmarks", "[.][benchmark]")
+{
+    constexpr int count = 10'000'000;
+
+    auto run = [](const std::string& desc, const Shape& group) {
+        BENCHMARK("draw 10M shapes - " + desc)
+        {
+            draw_sink = 0;
+            group.draw();
+            return draw_sink;
+        };
+    };
+
+    {
+        ver_1_0::ShapeGroup group;
+        group.shapes.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            if (i % 4 == 0)
+                group.add(std::make_unique<Box>(i, i, 2, 3));
+            else
+                group.add(std::make_unique<Dot>(i, i));
+        }
+
+        run("std::vector<std::unique_ptr<Shape>>", group);
+
+        // a long-running program allocates shapes at scattered addresses
+        std::shuffle(group.shapes.begin(), group.shapes.end(), std::mt19937_64{665});
+        run("std::vector<std::unique_ptr<Shape>> (scattered heap)", group);
+    }
+
+    {
+        ShapeGroup group;
+        group.shapes.reserve(count, count * sizeof(Box));
+        for (int i = 0; i < count; ++i)
+        {
+            if (i % 4 == 0)
+                group.emplace<Box>(i, i, 2, 3);
+            else
+                group.emplace<Dot>(i, i);
+        }
+
+        run("poly_vector<Shape>", group);
+    }
+}
+
+namespace
+{
+    struct Marker : Shape
+    {
+        int id;
+
+        explicit Marker(int id)
+            : id{id}
+        { }
+
+        void draw() const override
+        {
+            std::cout << "Marker " << id << "\n";
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            out << "Marker " << id << "\n";
+        }
+    };
+
+    struct Circle : Shape
+    {
+        int x, y, radius;
+
+        Circle(int x, int y, int radius)
+            : x{x}
+            , y{y}
+            , radius{radius}
+        { }
+
+        void draw() const override
+        {
+            draw_sink += radius * radius * 3 + x - y;
+        }
+
+        void draw(RenderBuffer& out) const override
+        {
+            out << "Circle at: [" << x << ", " << y << "] radius: " << radius << "\n";
+        }
+    };
+
+    class CoutCapture
+    {
+        std::ostringstream output_;
+        std::streambuf* original_;
+
+    public:
+        CoutCapture()
+            : original_{std::cout.rdbuf(output_.rdbuf())}
+        { }
+
+        ~CoutCapture()
+        {
+            std::cout.rdbuf(original_);
+        }
+
+        std::string str() const
+        {
+            return output_.str();
+        }
+    };
+} // namespace
+
+TEST_CASE("ShapeBatches - batched drawing")
+{
+    ShapeBatches<Text, Marker> scene;
+    scene.emplace<Text>(1, 2, "a");
+    scene.emplace<Marker>(1);
+    scene.emplace<Marker>(2);
+    scene.emplace<Text>(3, 4, "b");
+
+    REQUIRE(scene.size() == 4);
+    REQUIRE(scene.count<Text>() == 2);
+
+    SECTION("by type")
+    {
+        CoutCapture output;
+        scene.draw(DrawOrder::by_type);
+
+        REQUIRE(output.str() == "Rendering text 'a' at: [1, 2]\nRendering text 'b' at: [3, 4]\nMarker 1\nMarker 2\n");
+    }
+
+    SECTION("z-order is preserved")
+    {
+        CoutCapture output;
+        scene.draw(DrawOrder::z_order);
+
+        REQUIRE(output.str() == "Rendering text 'a' at: [1, 2]\nMarker 1\nMarker 2\nRendering text 'b' at: [3, 4]\n");
+    }
+
+    SECTION("batches can be a part of a ShapeGroup")
+    {
+        ShapeGroup group;
+        group.emplace<ShapeBatches<Text, Marker>>(DrawOrder::z_order);
+        auto& nested = dynamic_cast<ShapeBatches<Text, Marker>&>(*group.shapes[0]);
+        nested.emplace<Marker>(7);
+
+        CoutCapture output;
+        group.draw();
+
+        REQUIRE(output.str() == "Marker 7\n");
+    }
+}
+
+TEST_CASE("ShapeBatches - draw - benchmarks", "[.][benchmark]")
+{
+    constexpr int count = 1'000'000;
+
+    for (int run_length : {1, 16})
+    {
+        // every run_length shapes the type is chosen at random
+        std::mt19937 rnd{665};
+        std::vector<int> types(count);
+        for (int i = 0; i < count; i += run_length)
+            std::fill_n(types.begin() + i, std::min(run_length, count - i), static_cast<int>(rnd() % 3));
+
+        ShapeGroup group;
+        ShapeBatches<Dot, Box, Circle> batches;
+        for (int i = 0; i < count; ++i)
+        {
+            switch (types[i])
+            {
+            case 0:
+                group.emplace<Dot>(i, i);
+                batches.emplace<Dot>(i, i);
+                break;
+            case 1:
+                group.emplace<Box>(i, i, 2, 3);
+                batches.emplace<Box>(i, i, 2, 3);
+                break;
+            default:
+                group.emplace<Circle>(i, i, 5);
+                batches.emplace<Circle>(i, i, 5);
+                break;
+            }
+        }
+
+        const std::string desc = "1M mixed shapes (runs of " + std::to_string(run_length) + ") - ";
+
+        BENCHMARK(desc + "ShapeGroup - virtual dispatch")
+        {
+            draw_sink = 0;
+            group.draw();
+            return draw_sink;
+        };
+
+        BENCHMARK(desc + "ShapeBatches - by type")
+        {
+            draw_sink = 0;
+            batches.draw(DrawOrder::by_type);
+            return draw_sink;
+        };
+
+        BENCHMARK(desc + "ShapeBatches - z-order")
+        {
+            draw_sink = 0;
+            batches.draw(DrawOrder::z_order);
+            return draw_sink;
+        };
+    }
+}
+
+namespace
+{
+    std::string read_file(const std::filesystem::path& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    // removes the file at the end of a test
+    struct TemporaryFile
+    {
+        std::filesystem::path path;
+
+        explicit TemporaryFile(const std::string& name)
+            : path{std::filesystem::temp_directory_path() / name}
+        { }
+
+        ~TemporaryFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    };
+} // namespace
+
+TEST_CASE("Render pipeline")
+{
+    ShapeGroup group;
+    for (int i = 0; i < 100; ++i)
+        group.emplace<Text>(i, -i, "text" + std::to_string(i));
+    auto nested = group.emplace<ShapeGroup>();
+    dynamic_cast<ShapeGroup&>(*nested).emplace<Text>(1, 2, "nested");
+
+    std::string expected;
+    {
+        CoutCapture output;
+        group.draw();
+        expected = output.str();
+    }
+
+    SECTION("a buffer formats like the stream")
+    {
+        RenderBuffer buffer;
+        group.draw(buffer);
+
+        REQUIRE(buffer.view() == expected);
+    }
+
+    SECTION("output does not depend on the number of threads")
+    {
+        for (size_t threads_count : {1, 2, 7, 200})
+        {
+            std::ostringstream out;
+            OstreamTarget target{out};
+            RenderPipeline pipeline{threads_count};
+
+            pipeline.render(group, target);
+            pipeline.render(group, target); // buffers are reused
+
+            REQUIRE(out.str() == expected + expected);
+        }
+    }
+
+    SECTION("nested ShapeBatches and shapes of other types are drawn into the target")
+    {
+        ShapeGroup scene;
+        scene.emplace<Text>(0, 0, "first");
+        auto batches = scene.emplace<ShapeBatches<Text, Marker>>(DrawOrder::z_order);
+        auto& nested = dynamic_cast<ShapeBatches<Text, Marker>&>(*batches);
+        nested.emplace<Text>(1, 1, "batched");
+        nested.emplace<Marker>(7);
+        scene.emplace<Dot>(2, 3);
+        scene.emplace<Text>(4, 4, "last");
+
+        CoutCapture cout_output;
+        std::ostringstream out;
+        OstreamTarget target{out};
+        RenderPipeline{2}.render(scene, target);
+
+        REQUIRE(out.str()
+            == "Rendering text 'first' at: [0, 0]\n"
+               "Rendering text 'batched' at: [1, 1]\n"
+               "Marker 7\n"
+               "Dot at: [2, 3]\n"
+               "Rendering text 'last' at: [4, 4]\n");
+        REQUIRE(cout_output.str().empty());
+    }
+
+    SECTION("batches format in the chosen order")
+    {
+        ShapeBatches<Text, Marker> scene;
+        scene.emplace<Marker>(1);
+        scene.emplace<Text>(1, 2, "a");
+
+        RenderBuffer by_type, z_order;
+        scene.draw(by_type, DrawOrder::by_type);
+        scene.draw(z_order, DrawOrder::z_order);
+
+        REQUIRE(by_type.view() == "Rendering text 'a' at: [1, 2]\nMarker 1\n");
+        REQUIRE(z_order.view() == "Marker 1\nRendering text 'a' at: [1, 2]\n");
+    }
+
+    SECTION("empty group")
+    {
+        std::ostringstream out;
+        OstreamTarget target{out};
+        RenderPipeline{4}.render(ShapeGroup{}, target);
+
+        REQUIRE(out.str().empty());
+    }
+
+    SECTION("writing to a file")
+    {
+        TemporaryFile file{"render_pipeline_test.txt"};
+        {
+            FileTarget target{file.path.string()};
+            RenderPipeline{3}.render(group, target);
+            target.write("end\n");
+        }
+
+        REQUIRE(read_file(file.path) == expected + "end\n");
+    }
+}
+
+TEST_CASE("Render pipeline - draw 1M texts to a file - benchmarks", "[.][benchmark]")
+{
+    constexpr int count = 1'000'000;
+    const size_t threads_count = std::max(4u, std::thread::hardware_concurrency());
+
+    ShapeGroup group;
+    std::vector<ver_1_0::Text> legacy_texts;
+    group.shapes.reserve(count, count * sizeof(Text));
+    legacy_texts.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const std::string text = "text #" + std::to_string(i);
+        group.emplace<Text>(i, i % 768, text);
+        legacy_texts.emplace_back(i, i % 768, text);
+    }
+
+    TemporaryFile file{"render_pipeline_benchmark.txt"};
+
+    BENCHMARK("std::cout redirected to a file - std::endl after every text")
+    {
+        std::ofstream out{file.path};
+        auto* original = std::cout.rdbuf(out.rdbuf());
+        for (const auto& text : legacy_texts)
+            text.draw();
+        std::cout.rdbuf(original);
+        return out.tellp();
+    };
+
+    BENCHMARK("std::cout redirected to a file - Text::draw()")
+    {
+        std::ofstream out{file.path};
+        auto* original = std::cout.rdbuf(out.rdbuf());
+        group.draw();
+        std::cout.rdbuf(original);
+        return out.tellp();
+    };
+
+    RenderPipeline sequential{1};
+    BENCHMARK("RenderPipeline - sequential - FileTarget")
+    {
+        FileTarget target{file.path.string()};
+        sequential.render(group, target);
+    };
+
+    RenderPipeline parallel{threads_count};
+    BENCHMARK("RenderPipeline - parallel (" + std::to_string(threads_count) + " threads) - FileTarget")
+    {
+        FileTarget target{file.path.string()};
+        parallel.render(group, target);
+    };
+}
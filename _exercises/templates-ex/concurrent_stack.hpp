@@ -0,0 +1,102 @@
+#ifndef CONCURRENT_STACK_HPP_
+#define CONCURRENT_STACK_HPP_
+
+#include "hazard_pointers.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Lock-free stack (R. K. Treiber, 1986) - push & try_pop are a single CAS on the head.
+// ABA: a popped node is retired with a hazard pointer - its address cannot be reused
+// while any thread still reads it, so a successful CAS always sees the same node.
+// There is no top() & pop() - two separate calls are not atomic; use try_pop(T&).
+template <typename T>
+class ConcurrentStack
+{
+    struct Node
+    {
+        T item;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+    std::atomic<size_t> size_{0};
+
+public:
+    using value_type = T;
+
+    ConcurrentStack() = default;
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    // no other thread may use the stack during destruction
+    ~ConcurrentStack()
+    {
+        for (Node* node = head_.load(std::memory_order_relaxed); node;)
+            delete std::exchange(node, node->next);
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // approximate when other threads push or pop - may count an item that is being pushed
+    size_t size() const
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    template <typename U>
+    void push(U&& item)
+    {
+        emplace(std::forward<U>(item));
+    }
+
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        Node* node = new Node{T(std::forward<TArgs>(args)...), head_.load(std::memory_order_relaxed)};
+        // counted before the node is published - the release CAS orders it before the fetch_sub
+        // of a thread that pops the node, so size() never wraps below zero
+        size_.fetch_add(1, std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    bool try_pop(T& item)
+    {
+        std::atomic<void*>& hazard_pointer = HazardPointers::hazard_pointer();
+
+        Node* old_head = head_.load(std::memory_order_acquire);
+        do
+        {
+            // protect the head - then check that it was not popped (and maybe deleted) in the meantime
+            Node* protected_head;
+            do
+            {
+                protected_head = old_head;
+                hazard_pointer.store(protected_head);
+                old_head = head_.load();
+            } while (old_head != protected_head);
+
+            if (!old_head)
+            {
+                hazard_pointer.store(nullptr, std::memory_order_release);
+                return false;
+            }
+        } while (!head_.compare_exchange_strong(old_head, old_head->next, std::memory_order_acquire, std::memory_order_acquire));
+
+        hazard_pointer.store(nullptr, std::memory_order_release);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+
+        // only this thread owns the node now - other threads may still read its next
+        item = std::move(old_head->item);
+        HazardPointers::retire(old_head);
+
+        return true;
+    }
+};
+
+#endif /*CONCURRENT_STACK_HPP_*/
@@ -0,0 +1,145 @@
+#ifndef HAZARD_POINTERS_HPP_
+#define HAZARD_POINTERS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Safe memory reclamation for lock-free structures (M. Michael, "Hazard Pointers", 2004):
+//  * before dereferencing a shared node a thread publishes its address in its hazard pointer
+//  * removed nodes are retired - they are deleted only when no hazard pointer points to them
+// Each thread owns one hazard pointer (enough for a Treiber stack); a record is released when the thread ends.
+namespace HazardPointers
+{
+    constexpr size_t max_threads = 256;
+
+    struct alignas(64) Record
+    {
+        std::atomic<bool> is_active{false};
+        std::atomic<void*> pointer{nullptr};
+    };
+
+    inline Record records[max_threads];
+
+    struct Retired
+    {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    // retired nodes left by threads that ended while their nodes were still protected
+    inline std::mutex orphans_mtx;
+    inline std::vector<Retired> orphans;
+
+    class RecordOwner
+    {
+        Record* record_;
+
+    public:
+        RecordOwner()
+        {
+            for (Record& record : records)
+            {
+                bool expected = false;
+                if (!record.is_active.load(std::memory_order_relaxed) && record.is_active.compare_exchange_strong(expected, true))
+                {
+                    record_ = &record;
+                    return;
+                }
+            }
+
+            throw std::runtime_error("HazardPointers - no free hazard pointer records");
+        }
+
+        RecordOwner(const RecordOwner&) = delete;
+        RecordOwner& operator=(const RecordOwner&) = delete;
+
+        ~RecordOwner()
+        {
+            record_->pointer.store(nullptr);
+            record_->is_active.store(false);
+        }
+
+        std::atomic<void*>& pointer()
+        {
+            return record_->pointer;
+        }
+    };
+
+    inline std::atomic<void*>& hazard_pointer()
+    {
+        thread_local RecordOwner owner;
+        return owner.pointer();
+    }
+
+    class RetiredList
+    {
+        std::vector<Retired> items_;
+
+        static constexpr size_t scan_threshold = 2 * max_threads; // amortizes a scan over many retired nodes
+
+    public:
+        ~RetiredList()
+        {
+            scan();
+
+            if (!items_.empty())
+            {
+                std::lock_guard lk{orphans_mtx};
+                orphans.insert(orphans.end(), items_.begin(), items_.end());
+            }
+        }
+
+        void add(Retired retired)
+        {
+            items_.push_back(retired);
+            if (items_.size() >= scan_threshold)
+                scan();
+        }
+
+        // deletes retired nodes that are not protected by any hazard pointer
+        void scan()
+        {
+            {
+                std::lock_guard lk{orphans_mtx};
+                items_.insert(items_.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+
+            std::vector<void*> hazards;
+            hazards.reserve(max_threads);
+            for (Record& record : records)
+            {
+                if (void* ptr = record.pointer.load())
+                    hazards.push_back(ptr);
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            auto still_protected = std::partition(items_.begin(), items_.end(), [&](const Retired& retired) {
+                return std::binary_search(hazards.begin(), hazards.end(), retired.ptr);
+            });
+
+            for (auto it = still_protected; it != items_.end(); ++it)
+                it->deleter(it->ptr);
+            items_.erase(still_protected, items_.end());
+        }
+    };
+
+    inline RetiredList& retired_list()
+    {
+        thread_local RetiredList retired_list;
+        return retired_list;
+    }
+
+    // ptr must be already unreachable for other threads - it is deleted when no hazard pointer protects it
+    template <typename T>
+    void retire(T* ptr)
+    {
+        retired_list().add(Retired{ptr, [](void* p) { delete static_cast<T*>(p); }});
+    }
+} // namespace HazardPointers
+
+#endif /*HAZARD_POINTERS_HPP_*/
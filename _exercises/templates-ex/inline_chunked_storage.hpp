@@ -0,0 +1,292 @@
+#ifndef INLINE_CHUNKED_STORAGE_HPP_
+#define INLINE_CHUNKED_STORAGE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Storage for a Stack:
+//  * the first InlineCapacity items live inside of the object - small stacks never touch the heap
+//  * then items go to a list of contiguous chunks, each twice as large as the previous one
+//  * items are never moved or copied on growth - their addresses are stable
+//  * back() is a single pointer dereference (no block map like in std::deque)
+//  * one emptied chunk is kept as a spare, so push/pop around a chunk boundary does not allocate
+template <typename T, size_t InlineCapacity = 8>
+class InlineChunkedStorage
+{
+    static_assert(InlineCapacity > 0);
+
+    struct Chunk
+    {
+        Chunk* previous;
+        size_t capacity;
+    };
+
+    static constexpr size_t chunk_alignment = std::max(alignof(Chunk), alignof(T));
+    static constexpr size_t items_offset = (sizeof(Chunk) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    alignas(T) std::byte inline_items_[InlineCapacity * sizeof(T)];
+    Chunk* chunk_ = nullptr; // chunk with the top item - nullptr when all items are inline
+    Chunk* spare_ = nullptr;
+    T* segment_begin_ = inline_items();
+    T* top_ = inline_items();
+    T* segment_end_ = inline_items() + InlineCapacity;
+    size_t size_ = 0;
+
+    T* inline_items()
+    {
+        return reinterpret_cast<T*>(inline_items_);
+    }
+
+    const T* inline_items() const
+    {
+        return reinterpret_cast<const T*>(inline_items_);
+    }
+
+    static T* items_of(Chunk* chunk)
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(chunk) + items_offset);
+    }
+
+    static constexpr bool is_overaligned = chunk_alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static Chunk* allocate_chunk(Chunk* previous, size_t capacity)
+    {
+        const size_t bytes = items_offset + capacity * sizeof(T);
+        void* memory = is_overaligned ? ::operator new(bytes, std::align_val_t{chunk_alignment}) : ::operator new(bytes);
+        return ::new (memory) Chunk{previous, capacity};
+    }
+
+    static void deallocate_chunk(Chunk* chunk)
+    {
+        if constexpr (is_overaligned)
+            ::operator delete(chunk, std::align_val_t{chunk_alignment});
+        else
+            ::operator delete(chunk);
+    }
+
+    void enter_segment(Chunk* chunk, bool at_end)
+    {
+        chunk_ = chunk;
+        segment_begin_ = chunk ? items_of(chunk) : inline_items();
+        segment_end_ = segment_begin_ + (chunk ? chunk->capacity : InlineCapacity);
+        top_ = at_end ? segment_end_ : segment_begin_;
+    }
+
+    void grow()
+    {
+        Chunk* next = spare_;
+        if (next)
+        {
+            next->previous = chunk_; // the spare may come from a different position (e.g. before clear())
+            spare_ = nullptr;
+        }
+        else
+            next = allocate_chunk(chunk_, 2 * (chunk_ ? chunk_->capacity : InlineCapacity));
+
+        enter_segment(next, false);
+    }
+
+    void shrink()
+    {
+        if (spare_)
+            deallocate_chunk(spare_);
+        spare_ = chunk_;
+
+        enter_segment(chunk_->previous, true);
+    }
+
+    // calls f for all items - from the bottom to the top
+    template <typename TFunction>
+    void for_each_in_chunks(const Chunk* chunk, TFunction& f) const
+    {
+        if (!chunk)
+            return;
+
+        for_each_in_chunks(chunk->previous, f);
+
+        const T* first = items_of(const_cast<Chunk*>(chunk));
+        const T* last = chunk == chunk_ ? top_ : first + chunk->capacity;
+        std::for_each(first, last, f);
+    }
+
+    // precondition: *this is empty and has no chunks
+    void take_from(InlineChunkedStorage& other)
+    {
+        const size_t inline_count = other.chunk_ ? InlineCapacity : other.size_;
+        std::uninitialized_move(other.inline_items(), other.inline_items() + inline_count, inline_items());
+        std::destroy(other.inline_items(), other.inline_items() + inline_count);
+
+        if (other.chunk_)
+        {
+            chunk_ = other.chunk_;
+            segment_begin_ = other.segment_begin_;
+            top_ = other.top_;
+            segment_end_ = other.segment_end_;
+        }
+        else
+        {
+            top_ = inline_items() + inline_count;
+        }
+        spare_ = std::exchange(other.spare_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+
+        other.enter_segment(nullptr, false);
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_t inline_capacity = InlineCapacity;
+
+    InlineChunkedStorage() = default;
+
+    InlineChunkedStorage(const InlineChunkedStorage& other)
+    {
+        try
+        {
+            other.for_each([this](const T& item) { push_back(item); });
+        }
+        catch (...)
+        {
+            // the destructor of a partially constructed object is not called
+            clear();
+            if (spare_)
+                deallocate_chunk(spare_);
+            throw;
+        }
+    }
+
+    InlineChunkedStorage& operator=(const InlineChunkedStorage& other)
+    {
+        if (this != &other)
+        {
+            InlineChunkedStorage temp(other);
+            *this = std::move(temp);
+        }
+        return *this;
+    }
+
+    // inline items are moved one by one - noexcept only when T's move is
+    // if it throws, *this is left empty and other keeps all its items
+    InlineChunkedStorage(InlineChunkedStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        take_from(other);
+    }
+
+    InlineChunkedStorage& operator=(InlineChunkedStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            if (spare_)
+                deallocate_chunk(std::exchange(spare_, nullptr));
+            take_from(other);
+        }
+        return *this;
+    }
+
+    ~InlineChunkedStorage()
+    {
+        clear();
+        if (spare_)
+            deallocate_chunk(spare_);
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    // strong guarantee - if the constructor throws a chunk entered by grow() is left as the spare
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        const bool is_segment_full = top_ == segment_end_;
+        if (is_segment_full)
+            grow(); // args may refer to stored items - they are not moved by growth
+
+        T* item;
+        try
+        {
+            item = std::construct_at(top_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            if (is_segment_full)
+                shrink();
+            throw;
+        }
+        ++top_;
+        ++size_;
+        return *item;
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    T& back()
+    {
+        return top_[-1];
+    }
+
+    const T& back() const
+    {
+        return top_[-1];
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(--top_);
+        --size_;
+
+        if (top_ == segment_begin_ && chunk_)
+            shrink();
+    }
+
+    void clear()
+    {
+        std::destroy(segment_begin_, top_);
+
+        if (chunk_)
+        {
+            for (Chunk* chunk = chunk_->previous; chunk; chunk = chunk->previous)
+                std::destroy(items_of(chunk), items_of(chunk) + chunk->capacity);
+            std::destroy(inline_items(), inline_items() + InlineCapacity);
+
+            for (Chunk* chunk = chunk_; chunk;)
+                deallocate_chunk(std::exchange(chunk, chunk->previous));
+        }
+
+        enter_segment(nullptr, false);
+        size_ = 0;
+    }
+
+    template <typename TFunction>
+    void for_each(TFunction f) const
+    {
+        const T* inline_end = chunk_ ? inline_items() + InlineCapacity : top_;
+        std::for_each(inline_items(), inline_end, f);
+        for_each_in_chunks(chunk_, f);
+    }
+};
+
+#endif /*INLINE_CHUNKED_STORAGE_HPP_*/
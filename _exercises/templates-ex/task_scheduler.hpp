@@ -0,0 +1,315 @@
+#ifndef TASK_SCHEDULER_HPP_
+#define TASK_SCHEDULER_HPP_
+
+#include "work_stealing_deque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// counts tasks spawned in a fork/join region - scheduler.wait(group) returns when all of them are done
+class TaskGroup
+{
+    std::atomic<size_t> pending_{0};
+
+    friend class Task;
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void add()
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool is_done() const
+    {
+        return pending_.load(std::memory_order_acquire) == 0;
+    }
+};
+
+// type-erased task without std::function: one allocation holds the callable,
+// a plain function pointer runs it (unless the task is discarded) and destroys it
+class Task
+{
+    void (*run_and_destroy_)(Task*, bool);
+    TaskGroup* group_;
+
+protected:
+    Task(void (*run_and_destroy)(Task*, bool), TaskGroup& group)
+        : run_and_destroy_{run_and_destroy}
+        , group_{&group}
+    { }
+
+    ~Task() = default;
+
+public:
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    // tasks must not throw - there is nobody to catch an exception on a worker thread
+    static void execute(Task* task) noexcept
+    {
+        TaskGroup* group = task->group_;
+        task->run_and_destroy_(task, true);
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+
+    // destroys a task that could not be queued - the callable is not run
+    static void discard(Task* task) noexcept
+    {
+        TaskGroup* group = task->group_;
+        task->run_and_destroy_(task, false);
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+template <typename TFunction>
+class TaskFor final : public Task
+{
+    TFunction f_;
+
+    static void run_and_destroy(Task* task, bool run)
+    {
+        std::unique_ptr<TaskFor> self{static_cast<TaskFor*>(task)};
+        if (run)
+            self->f_();
+    }
+
+public:
+    TaskFor(TFunction f, TaskGroup& group)
+        : Task{&TaskFor::run_and_destroy, group}
+        , f_{std::move(f)}
+    { }
+};
+
+// the group counts the task only when it has been created - a throwing copy of f leaves the group done
+template <typename TFunction>
+Task* make_task(TFunction&& f, TaskGroup& group)
+{
+    Task* task = new TaskFor<std::decay_t<TFunction>>{std::forward<TFunction>(f), group};
+    group.add();
+    return task;
+}
+
+// thread pool with a work-stealing deque per worker:
+//  * a task spawned by a worker goes to the bottom of its own deque (no locking, no contention)
+//  * an idle worker steals from the top of a random victim's deque
+//  * tasks spawned by other threads go to a shared injection queue
+//  * wait(group) runs other tasks instead of blocking - nested fork/join does not deadlock
+class WorkStealingScheduler
+{
+    struct Worker
+    {
+        WorkStealingDeque<Task*> tasks;
+        std::minstd_rand random;
+
+        explicit Worker(unsigned seed)
+            : random{seed}
+        { }
+    };
+
+    struct CurrentWorker
+    {
+        WorkStealingScheduler* scheduler;
+        Worker* worker;
+    };
+
+    static inline thread_local CurrentWorker current_{}; // nullptrs for threads that are not workers
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex injected_mtx_;
+    std::deque<Task*> injected_;
+
+    std::atomic<size_t> queued_count_{0}; // tasks waiting in deques & injection queue - idle workers sleep when 0
+    std::atomic<size_t> sleepers_count_{0};
+    std::mutex sleep_mtx_;
+    std::condition_variable sleep_cv_;
+    std::atomic<bool> is_done_{false};
+
+    std::vector<std::jthread> threads_;
+
+    Worker* current_worker() const
+    {
+        return current_.scheduler == this ? current_.worker : nullptr;
+    }
+
+    bool try_steal(Worker* self, Task*& task)
+    {
+        const size_t count = workers_.size();
+        const size_t first_victim = self ? self->random() % count : 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Worker* victim = workers_[(first_victim + i) % count].get();
+            if (victim != self && victim->tasks.try_steal(task))
+                return true;
+        }
+
+        return false;
+    }
+
+    bool try_take_injected(Task*& task)
+    {
+        std::lock_guard lk{injected_mtx_};
+        if (injected_.empty())
+            return false;
+
+        task = injected_.front();
+        injected_.pop_front();
+        return true;
+    }
+
+    bool try_run_one(Worker* self)
+    {
+        Task* task;
+        if ((self && self->tasks.try_pop(task)) || try_steal(self, task) || try_take_injected(task))
+        {
+            queued_count_.fetch_sub(1, std::memory_order_relaxed);
+            Task::execute(task);
+            return true;
+        }
+
+        return false;
+    }
+
+    void wake_up_sleeper()
+    {
+        // seq_cst: either a worker going to sleep sees queued_count_ > 0 or we see it in sleepers_count_
+        if (sleepers_count_.load() > 0)
+        {
+            std::lock_guard lk{sleep_mtx_};
+            sleep_cv_.notify_one();
+        }
+    }
+
+    void sleep()
+    {
+        sleepers_count_.fetch_add(1);
+        {
+            std::unique_lock lk{sleep_mtx_};
+            sleep_cv_.wait(lk, [this] { return is_done_.load() || queued_count_.load() > 0; });
+        }
+        sleepers_count_.fetch_sub(1);
+    }
+
+    void run_worker(Worker* self)
+    {
+        current_ = CurrentWorker{this, self};
+
+        while (!is_done_.load(std::memory_order_relaxed))
+        {
+            if (try_run_one(self))
+                continue;
+
+            // a task may be on its way - a few yields are cheaper than a sleep & a wake-up
+            bool has_run = false;
+            for (int i = 0; i < 16 && !has_run; ++i)
+            {
+                std::this_thread::yield();
+                has_run = try_run_one(self);
+            }
+
+            if (!has_run)
+                sleep();
+        }
+
+        current_ = CurrentWorker{};
+    }
+
+    void stop()
+    {
+        is_done_.store(true);
+        {
+            std::lock_guard lk{sleep_mtx_};
+            sleep_cv_.notify_all();
+        }
+        threads_.clear(); // joins
+    }
+
+public:
+    explicit WorkStealingScheduler(size_t workers_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        std::random_device rd;
+        for (size_t i = 0; i < workers_count; ++i)
+            workers_.push_back(std::make_unique<Worker>(rd()));
+
+        try
+        {
+            for (auto& worker : workers_)
+                threads_.emplace_back([this, worker = worker.get()] { run_worker(worker); });
+        }
+        catch (...)
+        {
+            stop(); // workers that have already started would never leave run_worker()
+            throw;
+        }
+    }
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    // all groups must be waited for before destruction
+    ~WorkStealingScheduler()
+    {
+        stop();
+    }
+
+    size_t workers_count() const
+    {
+        return workers_.size();
+    }
+
+    template <typename TFunction>
+    void spawn(TaskGroup& group, TFunction&& f)
+    {
+        Task* task = make_task(std::forward<TFunction>(f), group);
+        queued_count_.fetch_add(1);
+
+        try
+        {
+            if (Worker* self = current_worker())
+            {
+                self->tasks.push(task);
+            }
+            else
+            {
+                std::lock_guard lk{injected_mtx_};
+                injected_.push_back(task);
+            }
+        }
+        catch (...) // bad_alloc when a queue grows - the task is not counted as pending any more
+        {
+            queued_count_.fetch_sub(1);
+            Task::discard(task);
+            throw;
+        }
+
+        wake_up_sleeper();
+    }
+
+    // runs other tasks until all tasks of the group are done
+    void wait(TaskGroup& group)
+    {
+        Worker* self = current_worker();
+        while (!group.is_done())
+        {
+            if (!try_run_one(self))
+                std::this_thread::yield();
+        }
+    }
+};
+
+#endif /*TASK_SCHEDULER_HPP_*/
@@ -1,8 +1,25 @@
+#include "concurrent_stack.hpp"
+#include "inline_chunked_storage.hpp"
+
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <deque>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 void foo(int x = 42)
 { }
@@ -47,6 +64,28 @@ public:
         items_.push_back(std::forward<U>(item));
     }
 
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        items_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    // items of an rvalue container are moved to the stack
+    template <std::ranges::input_range TRange>
+    void push_range(TRange&& range)
+    {
+        if constexpr (std::ranges::sized_range<TRange> && requires { items_.reserve(size_t{}); })
+            items_.reserve(items_.size() + std::ranges::size(range));
+
+        for (auto&& item : range)
+        {
+            if constexpr (std::is_lvalue_reference_v<TRange> || std::ranges::view<std::remove_cvref_t<TRange>>)
+                items_.push_back(std::forward<decltype(item)>(item));
+            else
+                items_.push_back(std::move(item));
+        }
+    }
+
     const T& top() const
     {
         return items_.back();
@@ -61,6 +100,30 @@ public:
     {
         items_.pop_back();
     }
+
+    // steals all items in O(1) - in push order (the top is at the back); the stack is left empty
+    TContainer drain()
+    {
+        return std::exchange(items_, TContainer{});
+    }
+
+    // moves all items to out in LIFO order - no default construction of T
+    template <typename OutputIt>
+    OutputIt drain_into(OutputIt out)
+    {
+        if constexpr (requires { items_.rbegin(); })
+        {
+            out = std::move(items_.rbegin(), items_.rend(), out);
+            items_.clear();
+        }
+        else
+        {
+            for (; !items_.empty(); items_.pop_back())
+                *out++ = std::move(items_.back());
+        }
+
+        return out;
+    }
 };
 
 namespace ver_2_0
@@ -75,8 +138,44 @@ namespace ver_2_0
         TContainer<T, TAllocator> items_;
 
     public:
+        using allocator_type = TAllocator; // with the allocator-extended constructors Stack is a uses-allocator type
+
         Stack() = default;
 
+        explicit Stack(const TAllocator& allocator)
+            : items_(allocator)
+        { }
+
+        Stack(const Stack&) = default;
+        Stack& operator=(const Stack&) = default;
+        Stack(Stack&&) = default;
+        Stack& operator=(Stack&&) = default; // propagates the allocator as the container does
+
+        Stack(const Stack& other, const TAllocator& allocator)
+            : items_(other.items_, allocator)
+        { }
+
+        // items are moved one by one when allocators are not equal
+        Stack(Stack&& other, const TAllocator& allocator)
+            : items_(std::move(other.items_), allocator)
+        { }
+
+        TAllocator get_allocator() const
+        {
+            return items_.get_allocator();
+        }
+
+        // precondition: equal allocators unless the allocator propagates on swap
+        void swap(Stack& other) noexcept
+        {
+            items_.swap(other.items_);
+        }
+
+        friend void swap(Stack& a, Stack& b) noexcept
+        {
+            a.swap(b);
+        }
+
         bool empty() const
         {
             return items_.empty();
@@ -103,6 +202,27 @@ namespace ver_2_0
             items_.push_back(std::forward<U>(item));
         }
 
+        template <typename... TArgs>
+        void emplace(TArgs&&... args)
+        {
+            items_.emplace_back(std::forward<TArgs>(args)...);
+        }
+
+        template <std::ranges::input_range TRange>
+        void push_range(TRange&& range)
+        {
+            if constexpr (std::ranges::sized_range<TRange> && requires { items_.reserve(size_t{}); })
+                items_.reserve(items_.size() + std::ranges::size(range));
+
+            for (auto&& item : range)
+            {
+                if constexpr (std::is_lvalue_reference_v<TRange> || std::ranges::view<std::remove_cvref_t<TRange>>)
+                    items_.push_back(std::forward<decltype(item)>(item));
+                else
+                    items_.push_back(std::move(item));
+            }
+        }
+
         const T& top() const
         {
             return items_.back();
@@ -117,7 +237,100 @@ namespace ver_2_0
         {
             items_.pop_back();
         }
+
+        // steals all items in O(1) - in push order (the top is at the back); the stack is left empty
+        TContainer<T, TAllocator> drain()
+        {
+            return std::exchange(items_, TContainer<T, TAllocator>(items_.get_allocator()));
+        }
+
+        // moves all items to out in LIFO order - no default construction of T
+        template <typename OutputIt>
+        OutputIt drain_into(OutputIt out)
+        {
+            if constexpr (requires { items_.rbegin(); })
+            {
+                out = std::move(items_.rbegin(), items_.rend(), out);
+                items_.clear();
+            }
+            else
+            {
+                for (; !items_.empty(); items_.pop_back())
+                    *out++ = std::move(items_.back());
+            }
+
+            return out;
+        }
     };
+
+    namespace pmr
+    {
+        template <typename T>
+        using VectorStack = Stack<T, std::vector, std::pmr::polymorphic_allocator<T>>;
+
+        template <typename T>
+        using DequeStack = Stack<T, std::deque, std::pmr::polymorphic_allocator<T>>;
+
+        template <typename TMemoryResource>
+        struct ResourceHolder
+        {
+            TMemoryResource resource;
+
+            template <typename... TArgs>
+            explicit ResourceHolder(TArgs&&... args)
+                : resource(std::forward<TArgs>(args)...)
+            { }
+        };
+
+        // a stack that owns its memory resource - the resource is constructed before and destroyed after the items
+        //  * TStack is a private base - a ResourceStack cannot be sliced & move-assigned as a TStack
+        //    (items would be left in the memory of another resource)
+        //  * no drain() & swap() - drained items would outlive the resource they are allocated in;
+        //    drain_into() moves items out (allocator-aware items should go to a pmr container
+        //    with its own resource - otherwise they keep the allocator of the stack)
+        template <typename TStack, typename TMemoryResource>
+        class ResourceStack : private ResourceHolder<TMemoryResource>, private TStack // base-from-member idiom
+        {
+        public:
+            using TStack::drain_into;
+            using TStack::emplace;
+            using TStack::empty;
+            using TStack::get_allocator;
+            using TStack::pop;
+            using TStack::push;
+            using TStack::push_range;
+            using TStack::size;
+            using TStack::top;
+
+            template <typename... TArgs>
+            explicit ResourceStack(TArgs&&... args)
+                : ResourceHolder<TMemoryResource>(std::forward<TArgs>(args)...)
+                , TStack(&this->resource)
+            { }
+
+            ResourceStack(const ResourceStack&) = delete;
+            ResourceStack& operator=(const ResourceStack&) = delete;
+
+            TMemoryResource& memory_resource()
+            {
+                return this->resource;
+            }
+        };
+
+        // arena - deallocation is a no-op, memory is released with the whole stack (for short-lived stacks)
+        template <typename T>
+        using MonotonicVectorStack = ResourceStack<VectorStack<T>, std::pmr::monotonic_buffer_resource>;
+
+        template <typename T>
+        using MonotonicDequeStack = ResourceStack<DequeStack<T>, std::pmr::monotonic_buffer_resource>;
+
+        // pools of blocks of the same size - freed memory is reused (for long-lived stacks)
+        template <typename T>
+        using PoolVectorStack = ResourceStack<VectorStack<T>, std::pmr::unsynchronized_pool_resource>;
+
+        template <typename T>
+        using PoolDequeStack = ResourceStack<DequeStack<T>, std::pmr::unsynchronized_pool_resource>;
+    } // namespace pmr
 } // namespace ver_2_0
 
 TEST_CASE("After construction", "[stack,constructors]")
@@ -171,16 +384,29 @@ TEST_CASE("Pushing an item", "[stack,push]")
     }
 }
 
-template <typename T>
-std::vector<T> pop_all(Stack<T>& s)
+namespace ver_1_0
 {
-    std::vector<T> values(s.size());
-
-    for (auto& item : values)
+    template <typename T>
+    std::vector<T> pop_all(Stack<T>& s)
     {
-        item = std::move(s.top());
-        s.pop();
+        std::vector<T> values(s.size());
+
+        for (auto& item : values)
+        {
+            item = std::move(s.top());
+            s.pop();
+        }
+
+        return values;
     }
+} // namespace ver_1_0
+
+template <typename T, typename TContainer>
+std::vector<T> pop_all(Stack<T, TContainer>& s)
+{
+    std::vector<T> values;
+    values.reserve(s.size());
+    s.drain_into(std::back_inserter(values));
 
     return values;
 }
@@ -287,4 +513,719 @@ TEST_CASE("Move semantics", "[stack,push,pop,move]")
         auto expected = {"txt3", "txt2", "txt1"};
         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
     }
-}
\ No newline at end of file
+}
+
+namespace
+{
+    struct NoDefault
+    {
+        int value;
+
+        explicit NoDefault(int value)
+            : value{value}
+        { }
+    };
+} // namespace
+
+TEST_CASE("Draining a stack", "[stack,pop]")
+{
+    SECTION("drain steals the container - items are in push order")
+    {
+        Stack<int, std::vector<int>> s;
+        s.push_range(std::vector{1, 2, 3});
+        const int* data = &s.top() - 2;
+
+        std::vector<int> items = s.drain();
+
+        REQUIRE(items == std::vector{1, 2, 3});
+        REQUIRE(items.data() == data); // no copy of items
+        REQUIRE(s.empty());
+    }
+
+    SECTION("drain_into moves items in LIFO order")
+    {
+        Stack<std::unique_ptr<std::string>> s;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+
+        std::vector<std::unique_ptr<std::string>> items;
+        s.drain_into(std::back_inserter(items));
+
+        REQUIRE(items.size() == 2);
+        REQUIRE(*items[0] == "txt2");
+        REQUIRE(*items[1] == "txt1");
+        REQUIRE(s.empty());
+    }
+
+    SECTION("items do not have to be default constructible")
+    {
+        ver_2_0::Stack<NoDefault, std::deque> s;
+        s.emplace(1);
+        s.emplace(2);
+
+        std::vector<NoDefault> items;
+        s.drain_into(std::back_inserter(items));
+
+        REQUIRE(items.size() == 2);
+        REQUIRE(items[0].value == 2);
+        REQUIRE(items[1].value == 1);
+    }
+
+    SECTION("storage without reverse iterators")
+    {
+        Stack<int, InlineChunkedStorage<int, 2>> s;
+        s.push_range(std::vector{1, 2, 3, 4, 5});
+
+        std::vector<int> items = pop_all(s);
+
+        REQUIRE(items == std::vector{5, 4, 3, 2, 1});
+        REQUIRE(s.empty());
+    }
+}
+
+TEST_CASE("Draining a stack - benchmarks", "[.][benchmark]")
+{
+    using Item = std::unique_ptr<int>;
+
+    // every run fills a stack - the fill-only run is a baseline to subtract
+    auto run = [](const std::string& desc, auto drain) {
+        BENCHMARK("push & drain 10M std::unique_ptr<int> - " + desc)
+        {
+            Stack<Item> s;
+            for (int i = 0; i < 10'000'000; ++i)
+                s.push(std::make_unique<int>(i));
+
+            return drain(s);
+        };
+    };
+
+    run("no drain (baseline)", [](auto& s) { return s.size(); });
+    run("ver_1_0::pop_all", [](auto& s) { return ver_1_0::pop_all(s).size(); });
+    run("pop_all with drain_into", [](auto& s) { return pop_all(s).size(); });
+    run("drain", [](auto& s) { return s.drain().size(); });
+}
+
+namespace
+{
+    template <typename TStack>
+    concept is_drainable = requires(TStack& s) { s.drain(); };
+} // namespace
+
+TEST_CASE("Allocator-aware stack", "[stack,allocators]")
+{
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    auto is_in_buffer = [&](const void* ptr) {
+        return ptr >= static_cast<const void*>(buffer.data()) && ptr < static_cast<const void*>(buffer.data() + buffer.size());
+    };
+
+    SECTION("items are allocated by the allocator passed to a constructor")
+    {
+        ver_2_0::pmr::VectorStack<int> s{&arena};
+        s.push(1);
+        s.push(2);
+
+        REQUIRE(s.get_allocator().resource() == &arena);
+        REQUIRE(is_in_buffer(&s.top()));
+    }
+
+    SECTION("uses-allocator construction of items")
+    {
+        ver_2_0::pmr::DequeStack<std::pmr::string> s{&arena};
+        s.push("a text long enough to be allocated on the heap");
+        s.emplace(10, 'x');
+
+        REQUIRE(s.top().get_allocator().resource() == &arena);
+        REQUIRE(is_in_buffer(s.top().data()));
+    }
+
+    SECTION("stack is a uses-allocator type")
+    {
+        using IntStack = ver_2_0::pmr::VectorStack<int>;
+        static_assert(std::uses_allocator_v<IntStack, std::pmr::polymorphic_allocator<IntStack>>);
+
+        std::pmr::vector<IntStack> stacks{&arena};
+        stacks.emplace_back();
+        stacks.back().push(1);
+
+        REQUIRE(stacks.back().get_allocator().resource() == &arena);
+        REQUIRE(is_in_buffer(&stacks.back().top()));
+    }
+
+    SECTION("move with a different allocator moves items to the new resource")
+    {
+        ver_2_0::pmr::VectorStack<std::pmr::string> source;
+        source.push("a text long enough to be allocated on the heap");
+
+        ver_2_0::pmr::VectorStack<std::pmr::string> target{std::move(source), &arena};
+
+        REQUIRE(target.get_allocator().resource() == &arena);
+        REQUIRE(target.top() == "a text long enough to be allocated on the heap");
+        REQUIRE(is_in_buffer(target.top().data()));
+    }
+
+    SECTION("polymorphic allocator does not propagate on move assignment")
+    {
+        ver_2_0::pmr::VectorStack<int> source;
+        source.push(1);
+
+        ver_2_0::pmr::VectorStack<int> target{&arena};
+        target = std::move(source);
+
+        REQUIRE(target.get_allocator().resource() == &arena);
+        REQUIRE(is_in_buffer(&target.top()));
+    }
+
+    SECTION("swap with equal allocators")
+    {
+        ver_2_0::pmr::VectorStack<int> a{&arena};
+        a.push(1);
+        ver_2_0::pmr::VectorStack<int> b{&arena};
+        b.push(2);
+        b.push(3);
+
+        swap(a, b);
+
+        REQUIRE(a.size() == 2);
+        REQUIRE(b.top() == 1);
+    }
+
+    SECTION("drain keeps the allocator")
+    {
+        ver_2_0::pmr::VectorStack<int> s{&arena};
+        s.push(1);
+
+        auto items = s.drain();
+        s.push(2);
+
+        REQUIRE(items.get_allocator().resource() == &arena);
+        REQUIRE(s.get_allocator().resource() == &arena);
+    }
+
+    SECTION("stacks owning their memory resource")
+    {
+        ver_2_0::pmr::MonotonicVectorStack<std::pmr::string> arena_stack{buffer.data(), buffer.size()};
+        arena_stack.push("a text long enough to be allocated on the heap");
+        REQUIRE(is_in_buffer(arena_stack.top().data()));
+        REQUIRE(arena_stack.get_allocator().resource() == &arena_stack.memory_resource());
+
+        ver_2_0::pmr::PoolDequeStack<int> pool_stack;
+        for (int i = 0; i < 1'000; ++i)
+            pool_stack.push(i);
+        REQUIRE(pool_stack.top() == 999);
+        REQUIRE(pool_stack.get_allocator().resource() == &pool_stack.memory_resource());
+    }
+
+    SECTION("stack owning its memory resource cannot be sliced or drained")
+    {
+        using ArenaStack = ver_2_0::pmr::MonotonicVectorStack<int>;
+        static_assert(!std::is_convertible_v<ArenaStack&, ver_2_0::pmr::VectorStack<int>&>);
+        static_assert(!is_drainable<ArenaStack>);
+        static_assert(is_drainable<ver_2_0::pmr::VectorStack<int>>);
+
+        ArenaStack s;
+        s.push_range(std::vector{1, 2, 3});
+
+        std::vector<int> items;
+        s.drain_into(std::back_inserter(items));
+
+        REQUIRE(items == std::vector{3, 2, 1});
+        REQUIRE(s.empty());
+    }
+}
+
+TEST_CASE("Allocator-aware stack - benchmarks", "[.][benchmark]")
+{
+    constexpr int requests_count = 1'000;
+    constexpr int items_per_request = 100;
+
+    // every request uses its own short-lived stack of strings
+    auto run = [](const std::string& desc, auto make_stack) {
+        BENCHMARK("1K requests x 100 strings - " + desc)
+        {
+            size_t total_length = 0;
+            for (int request = 0; request < requests_count; ++request)
+            {
+                auto&& s = make_stack();
+                for (int i = 0; i < items_per_request; ++i)
+                    s.emplace(48, static_cast<char>('a' + i % 26));
+
+                while (!s.empty())
+                {
+                    total_length += s.top().size();
+                    s.pop();
+                }
+            }
+            return total_length;
+        };
+    };
+
+    run("ver_2_0::Stack<std::string, std::vector>", [] { return ver_2_0::Stack<std::string, std::vector>{}; });
+    run("ver_2_0::Stack<std::string, std::deque>", [] { return ver_2_0::Stack<std::string, std::deque>{}; });
+
+    std::vector<std::byte> arena_buffer(64 * 1024);
+    run("MonotonicVectorStack<std::pmr::string>", [&] { return ver_2_0::pmr::MonotonicVectorStack<std::pmr::string>{arena_buffer.data(), arena_buffer.size()}; });
+    run("MonotonicDequeStack<std::pmr::string>", [&] { return ver_2_0::pmr::MonotonicDequeStack<std::pmr::string>{arena_buffer.data(), arena_buffer.size()}; });
+    run("PoolVectorStack<std::pmr::string>", [] { return ver_2_0::pmr::PoolVectorStack<std::pmr::string>{}; });
+    run("PoolDequeStack<std::pmr::string>", [] { return ver_2_0::pmr::PoolDequeStack<std::pmr::string>{}; });
+}
+
+TEST_CASE("Emplacing & pushing ranges", "[stack,push]")
+{
+    using namespace std::literals;
+
+    Stack<std::string> s;
+
+    SECTION("emplace constructs an item in place")
+    {
+        s.emplace(3, 'x');
+        REQUIRE(s.top() == "xxx"s);
+    }
+
+    SECTION("push_range pushes items in order")
+    {
+        const std::vector<std::string> words = {"one", "two", "three"};
+        s.push_range(words);
+
+        REQUIRE(s.size() == 3);
+        REQUIRE(s.top() == "three"s);
+        REQUIRE(words[0] == "one"s);
+    }
+
+    SECTION("push_range moves items of an rvalue range")
+    {
+        Stack<std::unique_ptr<int>> ptrs;
+
+        std::vector<std::unique_ptr<int>> source;
+        source.push_back(std::make_unique<int>(1));
+        source.push_back(std::make_unique<int>(2));
+        ptrs.push_range(std::move(source));
+
+        REQUIRE(*ptrs.top() == 2);
+    }
+
+    SECTION("push_range accepts views")
+    {
+        ver_2_0::Stack<int, std::vector> numbers;
+        numbers.push_range(std::views::iota(0, 10));
+
+        REQUIRE(numbers.size() == 10);
+        REQUIRE(numbers.top() == 9);
+    }
+}
+
+namespace
+{
+    struct ThrowingCopy
+    {
+        static inline int alive_count = 0;
+        static inline int copies_left = 0; // the copy after the last allowed one throws
+
+        ThrowingCopy()
+        {
+            ++alive_count;
+        }
+
+        ThrowingCopy(const ThrowingCopy&)
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error("copy failed");
+            ++alive_count;
+        }
+
+        ~ThrowingCopy()
+        {
+            --alive_count;
+        }
+    };
+} // namespace
+
+TEST_CASE("Inline-first chunked storage", "[stack,storage]")
+{
+    using Storage = InlineChunkedStorage<int, 4>;
+
+    auto is_inline = [](const Storage& storage, const int& item) {
+        auto* address = reinterpret_cast<const std::byte*>(&item);
+        auto* object = reinterpret_cast<const std::byte*>(&storage);
+        return address >= object && address < object + sizeof(storage);
+    };
+
+    SECTION("first items are stored inside of the object")
+    {
+        Storage storage;
+        for (int i = 0; i < 4; ++i)
+            storage.push_back(i);
+        REQUIRE(is_inline(storage, storage.back()));
+
+        storage.push_back(4);
+        REQUIRE(!is_inline(storage, storage.back()));
+    }
+
+    SECTION("addresses of items are stable while growing")
+    {
+        Storage storage;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < 1000; ++i)
+        {
+            storage.push_back(i);
+            addresses.push_back(&storage.back());
+        }
+
+        for (int i = 999; i >= 0; --i)
+        {
+            REQUIRE(&storage.back() == addresses[i]);
+            REQUIRE(storage.back() == i);
+            storage.pop_back();
+        }
+        REQUIRE(storage.empty());
+    }
+
+    SECTION("push & pop around chunk boundaries")
+    {
+        Stack<int, Storage> s;
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 100; ++i)
+                s.push(i);
+            for (int i = 0; i < 98; ++i)
+                s.pop();
+        }
+
+        REQUIRE(s.size() == 6);
+        REQUIRE(s.top() == 1);
+    }
+
+    SECTION("clear then push & pop across a chunk boundary")
+    {
+        Storage storage;
+        for (int i = 0; i < 100; ++i)
+            storage.push_back(i);
+        while (storage.size() > 40)
+            storage.pop_back(); // leaves a spare chunk
+
+        storage.clear();
+        for (int i = 0; i < 5; ++i)
+            storage.push_back(i); // the spare becomes the first chunk
+
+        storage.pop_back();
+        storage.pop_back();
+        REQUIRE(storage.size() == 3);
+        REQUIRE(storage.back() == 2);
+        REQUIRE(is_inline(storage, storage.back()));
+    }
+
+    SECTION("throwing constructor at a chunk boundary leaves the storage unchanged")
+    {
+        struct Item
+        {
+            int v;
+
+            Item(int v)
+                : v{v}
+            {
+                if (v < 0)
+                    throw std::runtime_error("negative item");
+            }
+        };
+
+        InlineChunkedStorage<Item, 2> storage;
+        storage.emplace_back(1);
+        storage.emplace_back(2);
+
+        REQUIRE_THROWS_AS(storage.emplace_back(-1), std::runtime_error);
+        REQUIRE(storage.size() == 2);
+        REQUIRE(storage.back().v == 2);
+
+        storage.emplace_back(3); // reuses the chunk left as the spare
+        REQUIRE(storage.back().v == 3);
+        storage.pop_back();
+        storage.pop_back();
+        REQUIRE(storage.back().v == 1);
+    }
+
+    SECTION("throwing copy does not leak items or chunks")
+    {
+        {
+            using CopyStorage = InlineChunkedStorage<ThrowingCopy, 2>;
+            CopyStorage storage;
+            for (int i = 0; i < 20; ++i)
+                storage.emplace_back();
+
+            ThrowingCopy::copies_left = 15;
+            REQUIRE_THROWS_AS(CopyStorage{storage}, std::runtime_error);
+            REQUIRE(ThrowingCopy::alive_count == 20);
+        }
+
+        REQUIRE(ThrowingCopy::alive_count == 0);
+    }
+
+    SECTION("move is noexcept only for items with noexcept move")
+    {
+        static_assert(std::is_nothrow_move_constructible_v<Storage>);
+        static_assert(std::is_nothrow_move_assignable_v<Storage>);
+        static_assert(!std::is_nothrow_move_constructible_v<InlineChunkedStorage<ThrowingCopy, 2>>);
+        static_assert(!std::is_nothrow_move_assignable_v<InlineChunkedStorage<ThrowingCopy, 2>>);
+    }
+
+    SECTION("copy & move")
+    {
+        Storage storage;
+        for (int i = 0; i < 50; ++i)
+            storage.push_back(i);
+
+        Storage copy = storage;
+        std::vector<int> items;
+        copy.for_each([&](int item) { items.push_back(item); });
+        REQUIRE(items.size() == 50);
+        REQUIRE(std::ranges::equal(items, std::views::iota(0, 50)));
+
+        const int* top_address = &storage.back();
+        Storage moved = std::move(storage);
+        REQUIRE(storage.empty());
+        REQUIRE(&moved.back() == top_address); // chunks are taken over
+        REQUIRE(moved.size() == 50);
+
+        copy = std::move(moved);
+        REQUIRE(copy.size() == 50);
+        REQUIRE(copy.back() == 49);
+    }
+
+    SECTION("move-only items")
+    {
+        Stack<std::unique_ptr<std::string>, InlineChunkedStorage<std::unique_ptr<std::string>, 2>> s;
+        for (int i = 0; i < 10; ++i)
+            s.emplace(std::make_unique<std::string>(std::to_string(i)));
+
+        auto moved_s = std::move(s);
+        REQUIRE(*moved_s.top() == "9");
+        REQUIRE(moved_s.size() == 10);
+    }
+}
+
+TEST_CASE("Stack storages - benchmarks", "[.][benchmark]")
+{
+    auto run = [](auto make_stack, const std::string& desc) {
+        for (int count : {3, 1'000, 1'000'000})
+        {
+            BENCHMARK("push & pop " + std::to_string(count) + " items - " + desc)
+            {
+                auto s = make_stack();
+                for (int i = 0; i < count; ++i)
+                    s.push(i);
+
+                long sum = 0;
+                while (!s.empty())
+                {
+                    sum += s.top();
+                    s.pop();
+                }
+                return sum;
+            };
+        }
+
+        BENCHMARK("top() x 1M - " + desc)
+        {
+            auto s = make_stack();
+            for (int i = 0; i < 100; ++i)
+                s.push(i);
+
+            long sum = 0;
+            for (int i = 0; i < 1'000'000; ++i)
+                sum += s.top();
+            return sum;
+        };
+    };
+
+    run([] { return Stack<int, std::deque<int>>{}; }, "Stack<int, std::deque>");
+    run([] { return Stack<int, std::vector<int>>{}; }, "Stack<int, std::vector>");
+    run([] { return ver_2_0::Stack<int, std::vector>{}; }, "ver_2_0::Stack<int, std::vector>");
+    run([] { return Stack<int, InlineChunkedStorage<int>>{}; }, "Stack<int, InlineChunkedStorage>");
+}
+
+TEST_CASE("Concurrent stack", "[stack,concurrency]")
+{
+    SECTION("items are popped in LIFO order")
+    {
+        ConcurrentStack<int> s;
+        for (int i = 1; i <= 3; ++i)
+            s.push(i);
+        REQUIRE(s.size() == 3);
+
+        int item{};
+        REQUIRE(s.try_pop(item));
+        REQUIRE(item == 3);
+        REQUIRE(s.try_pop(item));
+        REQUIRE(item == 2);
+        REQUIRE(s.try_pop(item));
+        REQUIRE(item == 1);
+        REQUIRE(s.empty());
+    }
+
+    SECTION("try_pop on empty stack returns false")
+    {
+        ConcurrentStack<int> s;
+        int item = 42;
+
+        REQUIRE_FALSE(s.try_pop(item));
+        REQUIRE(item == 42);
+    }
+
+    SECTION("move-only items")
+    {
+        ConcurrentStack<std::unique_ptr<std::string>> s;
+        auto ptr = std::make_unique<std::string>("text");
+        s.push(std::move(ptr));
+        s.emplace(std::make_unique<std::string>("more text"));
+
+        std::unique_ptr<std::string> item;
+        REQUIRE(s.try_pop(item));
+        REQUIRE(*item == "more text");
+        REQUIRE(s.try_pop(item));
+        REQUIRE(*item == "text");
+    }
+
+    SECTION("stress test - many threads push & pop concurrently")
+    {
+        constexpr int threads_count = 8;
+        constexpr int items_per_thread = 10'000;
+
+        ConcurrentStack<std::unique_ptr<std::string>> s;
+        std::vector<long> sums(threads_count);
+
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < threads_count; ++t)
+            {
+                threads.emplace_back([&s, &sum = sums[t], t] {
+                    std::unique_ptr<std::string> item;
+                    for (int i = 0; i < items_per_thread; ++i)
+                    {
+                        s.push(std::make_unique<std::string>(std::to_string(t * items_per_thread + i)));
+                        if (i % 2 == 1)
+                        {
+                            while (!s.try_pop(item))
+                                std::this_thread::yield();
+                            sum += std::stol(*item);
+                        }
+                    }
+                });
+            }
+        }
+
+        std::unique_ptr<std::string> item;
+        long sum = std::accumulate(sums.begin(), sums.end(), 0L);
+        while (s.try_pop(item))
+            sum += std::stol(*item);
+
+        constexpr long n = long{threads_count} * items_per_thread;
+        REQUIRE(sum == n * (n - 1) / 2);
+        REQUIRE(s.empty());
+        REQUIRE(s.size() == 0);
+    }
+
+    SECTION("size never wraps below zero while items are pushed & popped")
+    {
+        constexpr int threads_count = 4;
+        constexpr int items_per_thread = 10'000;
+
+        ConcurrentStack<int> s;
+        std::atomic<bool> done{false};
+        size_t max_size = 0;
+
+        {
+            std::jthread observer{[&] {
+                while (!done.load())
+                    max_size = std::max(max_size, s.size());
+            }};
+
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < threads_count; ++t)
+            {
+                threads.emplace_back([&s] {
+                    int item{};
+                    for (int i = 0; i < items_per_thread; ++i)
+                    {
+                        s.push(i);
+                        while (!s.try_pop(item))
+                            std::this_thread::yield();
+                    }
+                });
+            }
+
+            for (auto& thd : threads)
+                thd.join();
+            done = true;
+        }
+
+        REQUIRE(max_size <= threads_count);
+        REQUIRE(s.size() == 0);
+    }
+}
+
+namespace
+{
+    // the previous way of sharing a stack - an external mutex around push & top + pop
+    template <typename T>
+    class LockedStack
+    {
+        Stack<T> items_;
+        std::mutex mtx_;
+
+    public:
+        template <typename U>
+        void push(U&& item)
+        {
+            std::lock_guard lk{mtx_};
+            items_.push(std::forward<U>(item));
+        }
+
+        bool try_pop(T& item)
+        {
+            std::lock_guard lk{mtx_};
+            if (items_.empty())
+                return false;
+
+            item = std::move(items_.top());
+            items_.pop();
+            return true;
+        }
+    };
+} // namespace
+
+TEST_CASE("Concurrent stacks - benchmarks", "[.][benchmark]")
+{
+    constexpr int operations_count = 100'000;
+
+    auto run = [](auto make_stack, const std::string& desc) {
+        for (int threads_count : {1, 2, 4, 8, 16, 32, 64})
+        {
+            BENCHMARK(std::to_string(operations_count) + " push & pop - " + std::to_string(threads_count) + " threads - " + desc)
+            {
+                auto s = make_stack();
+                std::atomic<long> total{0};
+                {
+                    std::vector<std::jthread> threads;
+                    for (int t = 0; t < threads_count; ++t)
+                    {
+                        threads.emplace_back([&, threads_count] {
+                            long sum = 0;
+                            int item{};
+                            for (int i = 0; i < operations_count / threads_count; ++i)
+                            {
+                                s->push(i);
+                                if (s->try_pop(item))
+                                    sum += item;
+                            }
+                            total += sum;
+                        });
+                    }
+                }
+                return total.load();
+            };
+        }
+    };
+
+    run([] { return std::make_unique<LockedStack<int>>(); }, "Stack + std::mutex");
+    run([] { return std::make_unique<ConcurrentStack<int>>(); }, "ConcurrentStack");
+}
@@ -0,0 +1,330 @@
+#include "task_scheduler.hpp"
+#include "work_stealing_deque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Work-stealing deque", "[work_stealing]")
+{
+    WorkStealingDeque<int> deque{4};
+
+    SECTION("owner pops in LIFO order")
+    {
+        for (int i = 1; i <= 3; ++i)
+            deque.push(i);
+
+        int item{};
+        REQUIRE(deque.try_pop(item));
+        REQUIRE(item == 3);
+        REQUIRE(deque.try_pop(item));
+        REQUIRE(item == 2);
+        REQUIRE(deque.size() == 1);
+    }
+
+    SECTION("thieves steal in FIFO order")
+    {
+        for (int i = 1; i <= 3; ++i)
+            deque.push(i);
+
+        int item{};
+        REQUIRE(deque.try_steal(item));
+        REQUIRE(item == 1);
+        REQUIRE(deque.try_pop(item));
+        REQUIRE(item == 3);
+        REQUIRE(deque.try_steal(item));
+        REQUIRE(item == 2);
+        REQUIRE_FALSE(deque.try_pop(item));
+        REQUIRE_FALSE(deque.try_steal(item));
+        REQUIRE(deque.empty());
+    }
+
+    SECTION("grows beyond initial capacity")
+    {
+        for (int i = 0; i < 1'000; ++i)
+            deque.push(i);
+
+        std::vector<int> items;
+        for (int item; deque.try_pop(item);)
+            items.push_back(item);
+
+        REQUIRE(items.size() == 1'000);
+        REQUIRE(std::is_sorted(items.rbegin(), items.rend()));
+    }
+
+    SECTION("stress test - every item is taken exactly once")
+    {
+        constexpr int items_count = 100'000;
+        constexpr int thieves_count = 4;
+
+        std::vector<std::atomic<int>> taken(items_count);
+        std::atomic<bool> is_done{false};
+
+        {
+            std::vector<std::jthread> thieves;
+            for (int t = 0; t < thieves_count; ++t)
+            {
+                thieves.emplace_back([&] {
+                    int item;
+                    while (!is_done.load())
+                    {
+                        if (deque.try_steal(item))
+                            ++taken[item];
+                        else
+                            std::this_thread::yield();
+                    }
+                });
+            }
+
+            int item;
+            for (int i = 0; i < items_count; ++i)
+            {
+                deque.push(i);
+                if (i % 3 == 0 && deque.try_pop(item))
+                    ++taken[item];
+            }
+            while (deque.try_pop(item))
+                ++taken[item];
+
+            is_done = true;
+        }
+
+        REQUIRE(std::all_of(taken.begin(), taken.end(), [](const auto& count) { return count == 1; }));
+    }
+}
+
+namespace
+{
+    long fib(int n)
+    {
+        return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    }
+
+    template <typename TScheduler>
+    long parallel_fib(TScheduler& scheduler, int n, int serial_cutoff)
+    {
+        if (n <= serial_cutoff)
+            return fib(n);
+
+        long a;
+        TaskGroup group;
+        scheduler.spawn(group, [&] { a = parallel_fib(scheduler, n - 1, serial_cutoff); });
+        long b = parallel_fib(scheduler, n - 2, serial_cutoff);
+        scheduler.wait(group);
+
+        return a + b;
+    }
+
+    template <typename TScheduler, typename It>
+    void parallel_quicksort(TScheduler& scheduler, It first, It last)
+    {
+        if (last - first <= 2'048)
+        {
+            std::sort(first, last);
+            return;
+        }
+
+        auto pivot = *(first + (last - first) / 2);
+        It middle1 = std::partition(first, last, [pivot](const auto& item) { return item < pivot; });
+        It middle2 = std::partition(middle1, last, [pivot](const auto& item) { return !(pivot < item); });
+
+        TaskGroup group;
+        scheduler.spawn(group, [&scheduler, first, middle1] { parallel_quicksort(scheduler, first, middle1); });
+        parallel_quicksort(scheduler, middle2, last);
+        scheduler.wait(group);
+    }
+
+    // the previous way of balancing work - a single queue shared by all threads behind a mutex
+    class SharedQueueScheduler
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::deque<Task*> tasks_;
+        bool is_done_ = false;
+        std::vector<std::jthread> threads_;
+
+        bool try_run_one()
+        {
+            Task* task;
+            {
+                std::lock_guard lk{mtx_};
+                if (tasks_.empty())
+                    return false;
+
+                task = tasks_.front();
+                tasks_.pop_front();
+            }
+
+            Task::execute(task);
+            return true;
+        }
+
+        void run_worker()
+        {
+            while (true)
+            {
+                Task* task;
+                {
+                    std::unique_lock lk{mtx_};
+                    cv_.wait(lk, [this] { return is_done_ || !tasks_.empty(); });
+                    if (is_done_)
+                        return;
+
+                    task = tasks_.front();
+                    tasks_.pop_front();
+                }
+
+                Task::execute(task);
+            }
+        }
+
+    public:
+        explicit SharedQueueScheduler(size_t workers_count)
+        {
+            for (size_t i = 0; i < workers_count; ++i)
+                threads_.emplace_back([this] { run_worker(); });
+        }
+
+        ~SharedQueueScheduler()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                is_done_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        template <typename TFunction>
+        void spawn(TaskGroup& group, TFunction&& f)
+        {
+            Task* task = make_task(std::forward<TFunction>(f), group);
+            try
+            {
+                std::lock_guard lk{mtx_};
+                tasks_.push_back(task);
+            }
+            catch (...)
+            {
+                Task::discard(task);
+                throw;
+            }
+            cv_.notify_one();
+        }
+
+        void wait(TaskGroup& group)
+        {
+            while (!group.is_done())
+            {
+                if (!try_run_one())
+                    std::this_thread::yield();
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE("Work-stealing scheduler", "[work_stealing]")
+{
+    WorkStealingScheduler scheduler{4};
+    REQUIRE(scheduler.workers_count() == 4);
+
+    SECTION("runs tasks spawned from an outside thread")
+    {
+        std::atomic<int> counter{0};
+        std::string text = "text";
+
+        TaskGroup group;
+        for (int i = 0; i < 100; ++i)
+            scheduler.spawn(group, [&counter, text] { counter += static_cast<int>(text.size()); });
+        scheduler.wait(group);
+
+        REQUIRE(counter == 400);
+    }
+
+    SECTION("task that cannot be created is not counted in its group")
+    {
+        struct ThrowingCopy
+        {
+            ThrowingCopy() = default;
+
+            ThrowingCopy(const ThrowingCopy&)
+            {
+                throw std::runtime_error("copy failed");
+            }
+
+            void operator()() const
+            { }
+        };
+
+        TaskGroup group;
+        const ThrowingCopy f;
+        REQUIRE_THROWS_AS(scheduler.spawn(group, f), std::runtime_error);
+
+        REQUIRE(group.is_done());
+        scheduler.wait(group);
+    }
+
+    SECTION("nested fork/join - parallel fib")
+    {
+        REQUIRE(parallel_fib(scheduler, 25, 10) == fib(25));
+    }
+
+    SECTION("nested fork/join - parallel quicksort")
+    {
+        std::vector<int> items(200'000);
+        std::mt19937 rnd{42};
+        std::uniform_int_distribution<int> distr{0, 1'000};
+        std::generate(items.begin(), items.end(), [&] { return distr(rnd); });
+
+        parallel_quicksort(scheduler, items.begin(), items.end());
+
+        REQUIRE(std::is_sorted(items.begin(), items.end()));
+    }
+}
+
+TEST_CASE("Task schedulers - benchmarks", "[.][benchmark]")
+{
+    const size_t workers_count = std::max(2u, std::thread::hardware_concurrency());
+
+    std::vector<int> data(1'000'000);
+    std::mt19937 rnd{665};
+    std::generate(data.begin(), data.end(), [&] { return static_cast<int>(rnd()); });
+
+    auto run = [&](auto& scheduler, const std::string& desc) {
+        BENCHMARK("fib(30) - serial cutoff 15 - " + desc)
+        {
+            return parallel_fib(scheduler, 30, 15);
+        };
+
+        BENCHMARK("fib(30) - serial cutoff 8 - " + desc)
+        {
+            return parallel_fib(scheduler, 30, 8);
+        };
+
+        BENCHMARK("quicksort 1M ints - " + desc)
+        {
+            auto items = data;
+            parallel_quicksort(scheduler, items.begin(), items.end());
+            return items.front();
+        };
+    };
+
+    {
+        SharedQueueScheduler scheduler{workers_count};
+        run(scheduler, "shared locked queue - " + std::to_string(workers_count) + " workers");
+    }
+
+    {
+        WorkStealingScheduler scheduler{workers_count};
+        run(scheduler, "work stealing - " + std::to_string(workers_count) + " workers");
+    }
+}
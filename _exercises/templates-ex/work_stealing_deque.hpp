@@ -0,0 +1,154 @@
+#ifndef WORK_STEALING_DEQUE_HPP_
+#define WORK_STEALING_DEQUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Chase-Lev work-stealing deque (D. Chase, Y. Lev, "Dynamic Circular Work-Stealing Deque", 2005;
+// memory orders after N. M. Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models", 2013):
+//  * the owner thread pushes & pops at the bottom - LIFO, like a Stack (hot tasks stay in cache)
+//  * other threads steal from the top - the oldest (usually the largest) tasks
+//  * only the last item and steals need a CAS - owner's push & pop are plain loads and stores
+// Items are kept in atomic slots, so T must be trivially copyable (e.g. a pointer to a task).
+template <typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    class Buffer
+    {
+        int64_t mask_;
+        std::unique_ptr<std::atomic<T>[]> items_;
+
+    public:
+        explicit Buffer(int64_t capacity)
+            : mask_{capacity - 1}
+            , items_{new std::atomic<T>[capacity]}
+        { }
+
+        int64_t capacity() const
+        {
+            return mask_ + 1;
+        }
+
+        void put(int64_t index, T item)
+        {
+            items_[index & mask_].store(item, std::memory_order_relaxed);
+        }
+
+        T get(int64_t index) const
+        {
+            return items_[index & mask_].load(std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_; // thieves may still read from old buffers - they are freed with the deque
+
+    Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom)
+    {
+        auto bigger = std::make_unique<Buffer>(2 * buffer->capacity());
+        for (int64_t i = top; i < bottom; ++i)
+            bigger->put(i, buffer->get(i));
+
+        buffer = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(buffer, std::memory_order_release);
+
+        return buffer;
+    }
+
+public:
+    using value_type = T;
+
+    explicit WorkStealingDeque(size_t initial_capacity = 64)
+    {
+        size_t capacity = 1;
+        while (capacity < initial_capacity)
+            capacity *= 2;
+
+        buffers_.push_back(std::make_unique<Buffer>(static_cast<int64_t>(capacity)));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // approximate when other threads steal
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t size() const
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    // owner only
+    void push(T item)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top >= buffer->capacity())
+            buffer = grow(buffer, top, bottom);
+
+        buffer->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // owner only - takes the most recently pushed item
+    bool try_pop(T& item)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_seq_cst); // reserves the bottom item before top is read
+        int64_t top = top_.load(std::memory_order_seq_cst);
+
+        if (top > bottom) // empty
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = buffer->get(bottom);
+        if (top < bottom)
+            return true;
+
+        // the last item - race with thieves for it
+        const bool is_won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+        return is_won;
+    }
+
+    // any thread - takes the oldest item; fails when the deque is empty or another thread won the race
+    bool try_steal(T& item)
+    {
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+
+        if (top >= bottom)
+            return false;
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T stolen = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+
+        item = stolen;
+        return true;
+    }
+};
+
+#endif /*WORK_STEALING_DEQUE_HPP_*/
@@ -0,0 +1,105 @@
+#ifndef BATCH_HPP_
+#define BATCH_HPP_
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace Batch
+{
+    // fixed number of items processed together - one cache line by default
+    // plain arrays + simple loops are enough for the compiler to emit SIMD code
+    template <typename T, size_t Width = 64 / sizeof(T)>
+    struct batch
+    {
+        static constexpr size_t width = Width;
+
+        T lanes[Width];
+
+        static batch load(const T* ptr)
+        {
+            batch result;
+            std::memcpy(result.lanes, ptr, sizeof(result.lanes));
+            return result;
+        }
+
+        const T& operator[](size_t index) const
+        {
+            return lanes[index];
+        }
+
+        T& operator[](size_t index)
+        {
+            return lanes[index];
+        }
+    };
+
+    namespace Detail
+    {
+        template <size_t Size>
+        struct lane_int;
+
+        template <>
+        struct lane_int<1> { using type = int8_t; };
+
+        template <>
+        struct lane_int<2> { using type = int16_t; };
+
+        template <>
+        struct lane_int<4> { using type = int32_t; };
+
+        template <>
+        struct lane_int<8> { using type = int64_t; };
+    } // namespace Detail
+
+    // result of a batched predicate: 1 in a lane when the predicate holds, 0 otherwise
+    // lanes have the size of T, so compare results need no repacking
+    template <typename T>
+    using batch_mask = batch<typename Detail::lane_int<sizeof(T)>::type, batch<T>::width>;
+
+    // index of the first lane that is set or width if none
+    template <typename TLane, size_t Width>
+    size_t find_first(const batch<TLane, Width>& mask)
+    {
+        TLane any = 0;
+        for (size_t i = 0; i < Width; ++i)
+            any |= mask[i];
+
+        if (!any)
+            return Width;
+
+        size_t index = 0;
+        while (!mask[index])
+            ++index;
+        return index;
+    }
+
+    template <typename TLane, size_t Width>
+    size_t count(const batch<TLane, Width>& mask)
+    {
+        size_t result = 0;
+        for (size_t i = 0; i < Width; ++i)
+            result += mask[i];
+        return result;
+    }
+
+    // A predicate opts in by declaring 'using is_batched = std::true_type;' and providing
+    // 'batch_mask<T> operator()(const batch<T>&) const'. The tag guards against probing
+    // generic lambdas with a batch - deducing their return type is a hard error.
+    template <typename TPredicate, typename T>
+    concept BatchPredicate = TPredicate::is_batched::value && requires(const TPredicate& predicate, const batch<T>& items) {
+        { predicate(items) } -> std::same_as<batch_mask<T>>;
+    };
+
+    template <typename Iterator, typename TPredicate>
+    constexpr bool is_batchable_v = false;
+
+    template <std::contiguous_iterator Iterator, typename TPredicate>
+        requires std::is_arithmetic_v<std::iter_value_t<Iterator>> && BatchPredicate<TPredicate, std::iter_value_t<Iterator>>
+    constexpr bool is_batchable_v<Iterator, TPredicate> = true;
+} // namespace Batch
+
+#endif /*BATCH_HPP_*/
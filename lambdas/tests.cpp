@@ -1,9 +1,13 @@
+#include "batch.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -20,9 +24,24 @@ void print(const TContainer& container, const std::string& desc = "")
     std::cout << "]\n";
 }
 
+// algorithms below evaluate batched predicates a batch at a time
+// and fall back to one call per item for the rest (or for other predicates)
+
 template <typename Iterator, typename TPredicate>
 Iterator my_find_if(Iterator begin, Iterator end, TPredicate predicate)
 {
+    if constexpr (Batch::is_batchable_v<Iterator, TPredicate>)
+    {
+        using TBatch = Batch::batch<std::iter_value_t<Iterator>>;
+
+        for (; end - begin >= static_cast<std::ptrdiff_t>(TBatch::width); begin += TBatch::width)
+        {
+            size_t index = Batch::find_first(predicate(TBatch::load(std::to_address(begin))));
+            if (index != TBatch::width)
+                return begin + index;
+        }
+    }
+
     for (Iterator pos = begin; pos != end; ++pos)
     {
         if (predicate(*pos))
@@ -32,6 +51,66 @@ Iterator my_find_if(Iterator begin, Iterator end, TPredicate predicate)
     return end;
 }
 
+template <typename Iterator, typename TPredicate>
+std::iter_difference_t<Iterator> my_count_if(Iterator begin, Iterator end, TPredicate predicate)
+{
+    std::iter_difference_t<Iterator> result = 0;
+
+    if constexpr (Batch::is_batchable_v<Iterator, TPredicate>)
+    {
+        using TBatch = Batch::batch<std::iter_value_t<Iterator>>;
+
+        for (; end - begin >= static_cast<std::ptrdiff_t>(TBatch::width); begin += TBatch::width)
+            result += static_cast<std::iter_difference_t<Iterator>>(Batch::count(predicate(TBatch::load(std::to_address(begin)))));
+    }
+
+    for (Iterator pos = begin; pos != end; ++pos)
+    {
+        if (predicate(*pos))
+            ++result;
+    }
+
+    return result;
+}
+
+template <typename InputIterator, typename OutputIterator, typename TPredicate>
+OutputIterator my_copy_if(InputIterator begin, InputIterator end, OutputIterator target, TPredicate predicate)
+{
+    if constexpr (Batch::is_batchable_v<InputIterator, TPredicate>)
+    {
+        using TBatch = Batch::batch<std::iter_value_t<InputIterator>>;
+
+        for (; end - begin >= static_cast<std::ptrdiff_t>(TBatch::width); begin += TBatch::width)
+        {
+            const TBatch items = TBatch::load(std::to_address(begin));
+            const auto mask = predicate(items);
+
+            if (Batch::find_first(mask) == TBatch::width)
+                continue;
+
+            for (size_t i = 0; i < TBatch::width; ++i)
+            {
+                if (mask[i])
+                {
+                    *target = items[i];
+                    ++target;
+                }
+            }
+        }
+    }
+
+    for (InputIterator pos = begin; pos != end; ++pos)
+    {
+        if (predicate(*pos))
+        {
+            *target = *pos;
+            ++target;
+        }
+    }
+
+    return target;
+}
+
 bool is_even(int n)
 {
     return n % 2 == 0;
@@ -47,20 +126,48 @@ bool is_less_evil(int n)
 
 struct IsEven
 {
+    using is_batched = std::true_type;
+
     bool operator()(int n) const
     {
         return n % 2 == 0;
     }
+
+    Batch::batch_mask<int> operator()(const Batch::batch<int>& values) const
+    {
+        Batch::batch_mask<int> result;
+        for (size_t i = 0; i < values.width; ++i)
+            result[i] = (values[i] & 1) == 0;
+        return result;
+    }
 };
 
 struct IsDivisibleBy
 {
+    using is_batched = std::true_type;
+
     int n;
 
     bool operator()(int value) const
     {
         return value % n == 0;
     }
+
+    // there is no SIMD division - Lemire's test replaces it with a multiplication:
+    // for 32-bit x: x % d == 0 <=> x * c <= c - 1 (mod 2^64), where c = (2^64 - 1) / d + 1
+    Batch::batch_mask<int> operator()(const Batch::batch<int>& values) const
+    {
+        const uint64_t d = n < 0 ? 0u - static_cast<uint32_t>(n) : static_cast<uint32_t>(n);
+        const uint64_t c = UINT64_C(0xFFFFFFFFFFFFFFFF) / d + 1;
+
+        Batch::batch_mask<int> result;
+        for (size_t i = 0; i < values.width; ++i)
+        {
+            const uint64_t x = values[i] < 0 ? 0u - static_cast<uint32_t>(values[i]) : static_cast<uint32_t>(values[i]);
+            result[i] = x * c <= c - 1;
+        }
+        return result;
+    }
 };
 
 TEST_CASE("callables")
@@ -122,6 +229,127 @@ TEST_CASE("lambda expression")
     print(divs_by_3, "divs_by_3");
 }
 
+TEST_CASE("batched predicates")
+{
+    std::vector<int> numbers(1000);
+    std::iota(numbers.begin(), numbers.end(), -500);
+    numbers.push_back(std::numeric_limits<int>::min());
+    numbers.push_back(std::numeric_limits<int>::max());
+
+    SECTION("batch overload gives the same answers as per item call")
+    {
+        for (int divisor : {1, 2, 3, 7, 16, -5, 1000, 1'000'003})
+        {
+            IsDivisibleBy is_div{divisor};
+
+            for (size_t offset = 0; offset + 16 <= numbers.size(); offset += 16)
+            {
+                auto mask = is_div(Batch::batch<int>::load(numbers.data() + offset));
+                for (size_t i = 0; i < 16; ++i)
+                    REQUIRE(static_cast<bool>(mask[i]) == is_div(numbers[offset + i]));
+            }
+        }
+    }
+
+    SECTION("my_find_if")
+    {
+        auto pos = my_find_if(numbers.begin(), numbers.end(), IsDivisibleBy{499});
+        REQUIRE(pos == std::find_if(numbers.begin(), numbers.end(), IsDivisibleBy{499}));
+
+        pos = my_find_if(numbers.begin() + 1, numbers.end(), IsDivisibleBy{1'000'003});
+        REQUIRE(pos == std::find_if(numbers.begin() + 1, numbers.end(), IsDivisibleBy{1'000'003}));
+
+        pos = my_find_if(numbers.begin() + 999, numbers.end(), IsEven{});
+        REQUIRE(pos == numbers.begin() + 1000);
+    }
+
+    SECTION("my_count_if")
+    {
+        REQUIRE(my_count_if(numbers.begin(), numbers.end(), IsEven{}) == std::count_if(numbers.begin(), numbers.end(), IsEven{}));
+        REQUIRE(my_count_if(numbers.begin() + 3, numbers.end(), IsDivisibleBy{3}) == std::count_if(numbers.begin() + 3, numbers.end(), IsDivisibleBy{3}));
+    }
+
+    SECTION("my_copy_if")
+    {
+        std::vector<int> expected, result;
+        std::copy_if(numbers.begin(), numbers.end(), std::back_inserter(expected), IsDivisibleBy{7});
+        my_copy_if(numbers.begin(), numbers.end(), std::back_inserter(result), IsDivisibleBy{7});
+
+        REQUIRE(result == expected);
+    }
+
+    SECTION("per item fallback for lambdas")
+    {
+        int threshold = 400;
+        auto is_greater = [threshold](int n) { return n > threshold; };
+
+        REQUIRE(!Batch::is_batchable_v<std::vector<int>::iterator, decltype(is_greater)>);
+        REQUIRE(Batch::is_batchable_v<std::vector<int>::iterator, IsDivisibleBy>);
+
+        REQUIRE(my_count_if(numbers.begin(), numbers.end(), is_greater) == 100);
+        REQUIRE(*my_find_if(numbers.begin(), numbers.end(), [](auto n) { return n == 42; }) == 42);
+    }
+}
+
+TEST_CASE("batched predicates - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> numbers(100'000'000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+
+    BENCHMARK("std::find_if - IsDivisibleBy (no match)")
+    {
+        return std::find_if(numbers.begin() + 1, numbers.end(), IsDivisibleBy{200'000'000});
+    };
+
+    BENCHMARK("my_find_if - IsDivisibleBy (no match)")
+    {
+        return my_find_if(numbers.begin() + 1, numbers.end(), IsDivisibleBy{200'000'000});
+    };
+
+    BENCHMARK("std::count_if - IsDivisibleBy")
+    {
+        return std::count_if(numbers.begin(), numbers.end(), IsDivisibleBy{3});
+    };
+
+    BENCHMARK("my_count_if - IsDivisibleBy")
+    {
+        return my_count_if(numbers.begin(), numbers.end(), IsDivisibleBy{3});
+    };
+
+    BENCHMARK("std::count_if - IsEven")
+    {
+        return std::count_if(numbers.begin(), numbers.end(), IsEven{});
+    };
+
+    BENCHMARK("my_count_if - IsEven")
+    {
+        return my_count_if(numbers.begin(), numbers.end(), IsEven{});
+    };
+
+    BENCHMARK("my_count_if - capturing lambda")
+    {
+        int divisor = 3;
+        return my_count_if(numbers.begin(), numbers.end(), [divisor](int n) { return n % divisor == 0; });
+    };
+
+    std::vector<int> target;
+    target.reserve(numbers.size());
+
+    BENCHMARK("std::copy_if - IsDivisibleBy")
+    {
+        target.clear();
+        std::copy_if(numbers.begin(), numbers.end(), std::back_inserter(target), IsDivisibleBy{3});
+        return target.size();
+    };
+
+    BENCHMARK("my_copy_if - IsDivisibleBy")
+    {
+        target.clear();
+        my_copy_if(numbers.begin(), numbers.end(), std::back_inserter(target), IsDivisibleBy{3});
+        return target.size();
+    };
+}
+
 // closure class
 class Lambda_7286345283645
 {
@@ -0,0 +1,497 @@
+#ifndef SHARED_PTR_TRACKER_HPP_
+#define SHARED_PTR_TRACKER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+// Instrumentation is compiled in debug builds only - in release builds
+// make_tracked is std::make_shared and TrackedPtr<T> is std::shared_ptr<T>
+#ifndef NDEBUG
+#define ENABLE_SHARED_PTR_TRACKING
+#endif
+
+namespace Diagnostics
+{
+    template <typename T>
+    std::string type_name()
+    {
+        const char* mangled = typeid(T).name();
+#if __has_include(<cxxabi.h>)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled{abi::__cxa_demangle(mangled, nullptr, nullptr, &status), std::free};
+        if (status == 0 && demangled)
+            return demangled.get();
+#endif
+        return mangled;
+    }
+
+    // strongly connected component of objects kept alive only by each other
+    struct LeakedCycle
+    {
+        std::vector<const void*> objects;
+        std::vector<std::string> types;
+        size_t bytes = 0;
+    };
+
+    struct LeakReport
+    {
+        std::vector<LeakedCycle> cycles;
+        std::map<std::string, size_t> retained_bytes_by_type; // cycles + everything reachable only from them
+        size_t leaked_objects = 0;
+
+        bool empty() const
+        {
+            return leaked_objects == 0;
+        }
+    };
+
+    inline std::ostream& operator<<(std::ostream& out, const LeakReport& report)
+    {
+        out << "LeakReport{objects: " << report.leaked_objects << ", cycles: " << report.cycles.size() << "}\n";
+
+        for (const auto& cycle : report.cycles)
+        {
+            out << "  cycle (" << cycle.bytes << " bytes):";
+            for (size_t i = 0; i < cycle.objects.size(); ++i)
+                out << " " << cycle.types[i] << "@" << cycle.objects[i];
+            out << "\n";
+        }
+
+        for (const auto& [type, bytes] : report.retained_bytes_by_type)
+            out << "  retained " << bytes << " bytes of " << type << "\n";
+
+        return out;
+    }
+
+#ifdef ENABLE_SHARED_PTR_TRACKING
+
+    class SharedPtrRegistry
+    {
+        struct Node
+        {
+            size_t size;
+            std::string type;
+            std::weak_ptr<const void> handle;
+        };
+
+        mutable std::mutex mtx_;
+        std::map<const void*, Node> objects_;         // start address -> tracked object
+        std::map<const void*, const void*> members_; // address of TrackedPtr -> address of pointee
+
+        SharedPtrRegistry() = default;
+
+    public:
+        SharedPtrRegistry(const SharedPtrRegistry&) = delete;
+        SharedPtrRegistry& operator=(const SharedPtrRegistry&) = delete;
+
+        static SharedPtrRegistry& instance()
+        {
+            // intentionally leaked - tracked objects may outlive static destruction
+            static SharedPtrRegistry* registry = new SharedPtrRegistry();
+            return *registry;
+        }
+
+        void register_object(const void* ptr, size_t size, std::string type)
+        {
+            std::lock_guard lk{mtx_};
+            objects_.insert_or_assign(ptr, Node{size, std::move(type), {}});
+        }
+
+        void attach_handle(std::weak_ptr<const void> handle)
+        {
+            std::lock_guard lk{mtx_};
+            if (auto it = objects_.find(handle.lock().get()); it != objects_.end())
+                it->second.handle = std::move(handle);
+        }
+
+        void unregister_object(const void* ptr)
+        {
+            std::lock_guard lk{mtx_};
+            objects_.erase(ptr);
+        }
+
+        void set_edge(const void* member, const void* target)
+        {
+            std::lock_guard lk{mtx_};
+            members_.insert_or_assign(member, target);
+        }
+
+        void remove_edge(const void* member)
+        {
+            std::lock_guard lk{mtx_};
+            members_.erase(member);
+        }
+
+        size_t live_objects() const
+        {
+            std::lock_guard lk{mtx_};
+            return objects_.size();
+        }
+
+        LeakReport find_leaks() const;
+
+    private:
+        static const void* find_enclosing(const std::map<const void*, Node>& objects, const void* address)
+        {
+            auto it = objects.upper_bound(address);
+            if (it == objects.begin())
+                return nullptr;
+            --it;
+
+            auto start = reinterpret_cast<std::uintptr_t>(it->first);
+            auto addr = reinterpret_cast<std::uintptr_t>(address);
+            return addr < start + it->second.size ? it->first : nullptr;
+        }
+    };
+
+    inline LeakReport SharedPtrRegistry::find_leaks() const
+    {
+        std::lock_guard lk{mtx_};
+
+        const size_t n = objects_.size();
+        std::vector<std::map<const void*, Node>::const_iterator> nodes;
+        std::map<const void*, size_t> index_of;
+        for (auto it = objects_.begin(); it != objects_.end(); ++it)
+        {
+            index_of.emplace(it->first, nodes.size());
+            nodes.push_back(it);
+        }
+
+        // build the ownership graph - an edge owner -> target for every TrackedPtr living inside a tracked object
+        std::vector<std::vector<size_t>> edges(n);
+        std::vector<long> internal_refs(n, 0);
+        std::vector<bool> is_root(n, false);
+
+        for (const auto& [member, target] : members_)
+        {
+            const void* target_obj = target ? find_enclosing(objects_, target) : nullptr;
+            if (!target_obj)
+                continue;
+
+            size_t to = index_of.at(target_obj);
+            if (const void* owner = find_enclosing(objects_, member))
+            {
+                edges[index_of.at(owner)].push_back(to);
+                ++internal_refs[to];
+            }
+            else
+            {
+                is_root[to] = true; // TrackedPtr on a stack or in an untracked object
+            }
+        }
+
+        // any strong reference not explained by a tracked member (local shared_ptrs, plain shared_ptr members) is a root
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (nodes[i]->second.handle.use_count() > internal_refs[i])
+                is_root[i] = true;
+        }
+
+        std::vector<bool> reachable(n, false);
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (is_root[i])
+            {
+                reachable[i] = true;
+                pending.push_back(i);
+            }
+        }
+
+        while (!pending.empty())
+        {
+            size_t v = pending.back();
+            pending.pop_back();
+            for (size_t w : edges[v])
+            {
+                if (!reachable[w])
+                {
+                    reachable[w] = true;
+                    pending.push_back(w);
+                }
+            }
+        }
+
+        LeakReport report;
+
+        // Tarjan's SCC algorithm restricted to unreachable objects - iterative, so a long leaked chain
+        // (e.g. a linked list) cannot overflow the call stack
+        std::vector<long> order(n, -1), low(n, 0);
+        std::vector<bool> on_stack(n, false);
+        std::vector<size_t> stack;
+        long counter = 0;
+
+        struct Frame
+        {
+            size_t v;
+            size_t next_edge;
+        };
+
+        std::vector<Frame> call_stack;
+
+        auto visit = [&](size_t v) {
+            order[v] = low[v] = counter++;
+            stack.push_back(v);
+            on_stack[v] = true;
+            call_stack.push_back(Frame{v, 0});
+        };
+
+        auto pop_component = [&](size_t v) {
+            std::vector<size_t> component;
+            size_t w;
+            do
+            {
+                w = stack.back();
+                stack.pop_back();
+                on_stack[w] = false;
+                component.push_back(w);
+            } while (w != v);
+
+            bool has_cycle = component.size() > 1 || std::find(edges[v].begin(), edges[v].end(), v) != edges[v].end();
+            if (!has_cycle)
+                return;
+
+            LeakedCycle cycle;
+            for (size_t c : component)
+            {
+                cycle.objects.push_back(nodes[c]->first);
+                cycle.types.push_back(nodes[c]->second.type);
+                cycle.bytes += nodes[c]->second.size;
+            }
+            report.cycles.push_back(std::move(cycle));
+        };
+
+        auto strong_connect = [&](size_t root) {
+            visit(root);
+
+            while (!call_stack.empty())
+            {
+                Frame& frame = call_stack.back();
+                const size_t v = frame.v;
+
+                if (frame.next_edge < edges[v].size())
+                {
+                    size_t w = edges[v][frame.next_edge++];
+                    if (reachable[w])
+                        continue;
+
+                    if (order[w] == -1)
+                        visit(w); // frame is invalidated - low[v] is updated when w returns
+                    else if (on_stack[w])
+                        low[v] = std::min(low[v], order[w]);
+
+                    continue;
+                }
+
+                call_stack.pop_back();
+                if (!call_stack.empty())
+                {
+                    size_t parent = call_stack.back().v;
+                    low[parent] = std::min(low[parent], low[v]);
+                }
+
+                if (low[v] == order[v])
+                    pop_component(v);
+            }
+        };
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (reachable[i])
+                continue;
+
+            if (order[i] == -1)
+                strong_connect(i);
+
+            ++report.leaked_objects;
+            report.retained_bytes_by_type[nodes[i]->second.type] += nodes[i]->second.size;
+        }
+
+        return report;
+    }
+
+    // allocate_shared constructs and destroys the object through the allocator - it is our hook into the object's lifetime
+    template <typename T>
+    struct TrackingAllocator
+    {
+        using value_type = T;
+
+        TrackingAllocator() = default;
+
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U>&) noexcept
+        { }
+
+        T* allocate(size_t n)
+        {
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        template <typename U, typename... TArgs>
+        void construct(U* ptr, TArgs&&... args)
+        {
+            ::new (static_cast<void*>(ptr)) U(std::forward<TArgs>(args)...);
+            SharedPtrRegistry::instance().register_object(ptr, sizeof(U), type_name<U>());
+        }
+
+        template <typename U>
+        void destroy(U* ptr)
+        {
+            SharedPtrRegistry::instance().unregister_object(ptr);
+            ptr->~U();
+        }
+
+        template <typename U>
+        bool operator==(const TrackingAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    template <typename T, typename... TArgs>
+    std::shared_ptr<T> make_tracked(TArgs&&... args)
+    {
+        auto ptr = std::allocate_shared<T>(TrackingAllocator<T>{}, std::forward<TArgs>(args)...);
+        SharedPtrRegistry::instance().attach_handle(std::shared_ptr<const void>(ptr));
+        return ptr;
+    }
+
+    // drop-in replacement for a shared_ptr data member - registers an edge owner -> pointee
+    template <typename T>
+    class TrackedPtr
+    {
+        std::shared_ptr<T> ptr_;
+
+        void reset_to(std::shared_ptr<T> ptr)
+        {
+            SharedPtrRegistry::instance().set_edge(this, ptr.get());
+            ptr_.swap(ptr); // the previous pointee (if any) is released outside of the registry lock
+        }
+
+    public:
+        TrackedPtr()
+            : TrackedPtr(nullptr)
+        { }
+
+        TrackedPtr(std::nullptr_t)
+        {
+            SharedPtrRegistry::instance().set_edge(this, nullptr);
+        }
+
+        TrackedPtr(std::shared_ptr<T> ptr)
+        {
+            reset_to(std::move(ptr));
+        }
+
+        TrackedPtr(const TrackedPtr& other)
+            : TrackedPtr(other.ptr_)
+        { }
+
+        TrackedPtr(TrackedPtr&& other)
+            : TrackedPtr(std::move(other.ptr_))
+        {
+            other.reset_to(nullptr);
+        }
+
+        TrackedPtr& operator=(std::shared_ptr<T> ptr)
+        {
+            reset_to(std::move(ptr));
+            return *this;
+        }
+
+        TrackedPtr& operator=(const TrackedPtr& other)
+        {
+            if (this != &other)
+                reset_to(other.ptr_);
+            return *this;
+        }
+
+        TrackedPtr& operator=(TrackedPtr&& other)
+        {
+            if (this != &other)
+            {
+                reset_to(std::move(other.ptr_));
+                other.reset_to(nullptr);
+            }
+            return *this;
+        }
+
+        ~TrackedPtr()
+        {
+            SharedPtrRegistry::instance().remove_edge(this);
+        }
+
+        void reset()
+        {
+            reset_to(nullptr);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr_.get();
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr_.get();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return static_cast<bool>(ptr_);
+        }
+
+        operator std::shared_ptr<T>() const
+        {
+            return ptr_;
+        }
+    };
+
+    inline LeakReport find_leaks()
+    {
+        return SharedPtrRegistry::instance().find_leaks();
+    }
+
+#else
+
+    template <typename T, typename... TArgs>
+    std::shared_ptr<T> make_tracked(TArgs&&... args)
+    {
+        return std::make_shared<T>(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T>
+    using TrackedPtr = std::shared_ptr<T>;
+
+    inline LeakReport find_leaks()
+    {
+        return {};
+    }
+
+#endif
+} // namespace Diagnostics
+
+#endif /*SHARED_PTR_TRACKER_HPP_*/
@@ -1,6 +1,9 @@
+#include "shared_ptr_tracker.hpp"
+
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 class Human
 {
@@ -56,3 +59,144 @@ TEST_CASE("shared_ptrs leak - circular dependency")
 
     husband->description();
 }
+
+namespace Leaking
+{
+    // partner_ changed from weak_ptr to (tracked) shared_ptr - husband & wife keep each other alive
+    class Human
+    {
+    public:
+        Human(const std::string& name)
+            : name_(name)
+        {
+            std::cout << "Constructor Human(" << name_ << ")" << std::endl;
+        }
+
+        Human(const Human&) = delete;
+        Human& operator=(const Human&) = delete;
+
+        ~Human()
+        {
+            std::cout << "Destructor ~Human(" << name_ << ")" << std::endl;
+        }
+
+        void set_partner(std::shared_ptr<Human> partner)
+        {
+            partner_ = partner;
+        }
+
+    private:
+        Diagnostics::TrackedPtr<Human> partner_;
+        std::string name_;
+    };
+} // namespace Leaking
+
+#ifdef ENABLE_SHARED_PTR_TRACKING
+TEST_CASE("shared_ptrs leak - cycle detected by tracker")
+{
+    using Leaking::Human;
+
+    Human* husband_ptr{};
+
+    {
+        auto husband = Diagnostics::make_tracked<Human>("Jan");
+        auto wife = Diagnostics::make_tracked<Human>("Ewa");
+
+        husband->set_partner(wife);
+        wife->set_partner(husband);
+
+        REQUIRE(Diagnostics::find_leaks().empty()); // both still reachable from local roots
+
+        husband_ptr = husband.get();
+    }
+
+    Diagnostics::LeakReport report = Diagnostics::find_leaks();
+    std::cout << report;
+
+    REQUIRE(report.leaked_objects == 2);
+    REQUIRE(report.cycles.size() == 1);
+    REQUIRE(report.cycles[0].objects.size() == 2);
+    REQUIRE(report.cycles[0].bytes == 2 * sizeof(Human));
+    REQUIRE(report.retained_bytes_by_type.at(Diagnostics::type_name<Human>()) == 2 * sizeof(Human));
+
+    // breaking the cycle releases both objects
+    husband_ptr->set_partner(nullptr);
+    REQUIRE(Diagnostics::find_leaks().empty());
+    REQUIRE(Diagnostics::SharedPtrRegistry::instance().live_objects() == 0);
+}
+
+TEST_CASE("shared_ptrs leak - longer cycle detected by tracker")
+{
+    using Leaking::Human;
+
+    Human* husband_ptr{};
+
+    {
+        auto husband = Diagnostics::make_tracked<Human>("Jan");
+        auto wife = Diagnostics::make_tracked<Human>("Ewa");
+        auto lover = Diagnostics::make_tracked<Human>("Adam");
+
+        husband->set_partner(wife);
+        wife->set_partner(husband);
+        lover->set_partner(husband);
+        wife->set_partner(lover);
+
+        husband_ptr = husband.get();
+    }
+
+    Diagnostics::LeakReport report = Diagnostics::find_leaks();
+
+    REQUIRE(report.leaked_objects == 3);
+    REQUIRE(report.cycles.size() == 1);
+    REQUIRE(report.cycles[0].objects.size() == 3);
+
+    husband_ptr->set_partner(nullptr);
+    REQUIRE(Diagnostics::find_leaks().empty());
+}
+#endif
+
+#ifdef ENABLE_SHARED_PTR_TRACKING
+namespace
+{
+    struct ListNode : std::enable_shared_from_this<ListNode>
+    {
+        Diagnostics::TrackedPtr<ListNode> next;
+    };
+} // namespace
+
+TEST_CASE("shared_ptrs leak - long cycle does not overflow the stack")
+{
+    constexpr size_t length = 200'000;
+
+    std::vector<ListNode*> nodes;
+    {
+        auto head = Diagnostics::make_tracked<ListNode>();
+        ListNode* tail = head.get();
+        nodes.push_back(tail);
+        for (size_t i = 1; i < length; ++i)
+        {
+            auto node = Diagnostics::make_tracked<ListNode>();
+            tail->next = node;
+            tail = node.get();
+            nodes.push_back(tail);
+        }
+        tail->next = head; // circular list
+    }
+
+    Diagnostics::LeakReport report = Diagnostics::find_leaks();
+
+    REQUIRE(report.leaked_objects == length);
+    REQUIRE(report.cycles.size() == 1);
+    REQUIRE(report.cycles[0].objects.size() == length);
+
+    // one node at a time - releasing the list through its links would recurse as deep as the list is long
+    std::vector<std::shared_ptr<ListNode>> owners;
+    for (ListNode* node : nodes)
+        owners.push_back(node->shared_from_this());
+    for (ListNode* node : nodes)
+        node->next.reset();
+    owners.clear();
+
+    REQUIRE(Diagnostics::find_leaks().empty());
+}
+#endif
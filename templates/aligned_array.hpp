@@ -0,0 +1,114 @@
+#ifndef ALIGNED_ARRAY_HPP_
+#define ALIGNED_ARRAY_HPP_
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <span>
+
+// Array starting on (and padded to) an Align boundary - with the default alignment (a cache line
+// on x86-64 and most ARM cores) two AlignedArrays never share a cache line and SIMD kernels may use aligned loads
+template <typename T, size_t N, size_t Align = 64>
+struct alignas(Align) AlignedArray
+{
+    static_assert(Align >= alignof(T), "alignment must not be weaker than alignof(T)");
+    static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+
+    T items[N];
+
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_t alignment = Align;
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+    constexpr T* data()
+    {
+        return items;
+    }
+
+    constexpr const T* data() const
+    {
+        return items;
+    }
+
+    constexpr iterator begin()
+    {
+        return items;
+    }
+
+    constexpr iterator end()
+    {
+        return items + N;
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return items;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return items + N;
+    }
+
+    constexpr reference operator[](size_t index)
+    {
+        return items[index];
+    }
+
+    constexpr const_reference operator[](size_t index) const
+    {
+        return items[index];
+    }
+
+    constexpr void fill(const T& value)
+    {
+        std::fill(begin(), end(), value);
+    }
+
+    constexpr std::span<T, N> span()
+    {
+        return std::span<T, N>{items};
+    }
+
+    constexpr std::span<const T, N> span() const
+    {
+        return std::span<const T, N>{items};
+    }
+
+    constexpr operator std::span<T, N>()
+    {
+        return span();
+    }
+
+    constexpr operator std::span<const T, N>() const
+    {
+        return span();
+    }
+
+    constexpr bool operator==(const AlignedArray& other) const
+    {
+        return std::equal(begin(), end(), other.begin());
+    }
+
+    constexpr auto operator<=>(const AlignedArray& other) const
+    {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+};
+
+template <typename T>
+using AlignedBuffer = AlignedArray<T, 1024>;
+
+template <typename T>
+using AlignedLargeBuffer = AlignedArray<T, 2048>;
+
+#endif /*ALIGNED_ARRAY_HPP_*/
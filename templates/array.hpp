@@ -0,0 +1,258 @@
+#ifndef ARRAY_HPP_
+#define ARRAY_HPP_
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+template <typename T, size_t N>
+struct Array;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// Expression templates - arithmetic on Arrays builds a lazy expression tree,
+// which is evaluated in one fused loop when assigned to an Array
+
+namespace Expressions
+{
+    template <typename E>
+    struct ExpressionTraits
+    {
+        static constexpr bool is_expression = false;
+        static constexpr size_t size = 0;
+    };
+
+    template <typename T, size_t N>
+    struct ExpressionTraits<Array<T, N>>
+    {
+        static constexpr bool is_expression = true;
+        static constexpr size_t size = N;
+        using operand_type = const Array<T, N>&; // arrays are held by reference
+    };
+
+    template <typename E>
+    concept ArrayExpression = ExpressionTraits<std::remove_cvref_t<E>>::is_expression;
+
+    // scalar broadcast to every index
+    template <typename T>
+    struct Scalar
+    {
+        T value;
+
+        T operator[](size_t) const
+        {
+            return value;
+        }
+    };
+
+    template <typename TOp, typename TLhs, typename TRhs>
+    struct BinaryExpression
+    {
+        TLhs lhs;
+        TRhs rhs;
+
+        auto operator[](size_t index) const
+        {
+            return TOp{}(lhs[index], rhs[index]);
+        }
+    };
+
+    template <typename TOp, typename TLhs, typename TRhs>
+    struct ExpressionTraits<BinaryExpression<TOp, TLhs, TRhs>>
+    {
+        static constexpr bool is_expression = true;
+        static constexpr size_t size = ExpressionTraits<std::remove_cvref_t<TLhs>>::is_expression
+            ? ExpressionTraits<std::remove_cvref_t<TLhs>>::size
+            : ExpressionTraits<std::remove_cvref_t<TRhs>>::size;
+        using operand_type = BinaryExpression<TOp, TLhs, TRhs>; // nested expressions are temporaries - held by value
+    };
+
+    template <ArrayExpression E>
+    using operand_t = typename ExpressionTraits<std::remove_cvref_t<E>>::operand_type;
+
+    template <ArrayExpression E>
+    constexpr size_t size_v = ExpressionTraits<std::remove_cvref_t<E>>::size;
+
+    template <typename TOp, ArrayExpression TLhs, ArrayExpression TRhs>
+        requires(size_v<TLhs> == size_v<TRhs>)
+    auto make_expression(const TLhs& lhs, const TRhs& rhs)
+    {
+        return BinaryExpression<TOp, operand_t<TLhs>, operand_t<TRhs>>{lhs, rhs};
+    }
+
+    template <typename TOp, ArrayExpression TLhs, typename TScalar>
+        requires std::is_arithmetic_v<TScalar>
+    auto make_expression(const TLhs& lhs, TScalar rhs)
+    {
+        return BinaryExpression<TOp, operand_t<TLhs>, Scalar<TScalar>>{lhs, {rhs}};
+    }
+
+    template <typename TOp, typename TScalar, ArrayExpression TRhs>
+        requires std::is_arithmetic_v<TScalar>
+    auto make_expression(TScalar lhs, const TRhs& rhs)
+    {
+        return BinaryExpression<TOp, Scalar<TScalar>, operand_t<TRhs>>{{lhs}, rhs};
+    }
+
+    template <typename T, typename U>
+    concept Operands = (ArrayExpression<T> && (ArrayExpression<U> || std::is_arithmetic_v<U>))
+        || (std::is_arithmetic_v<T> && ArrayExpression<U>);
+
+    template <typename T>
+    concept LazyExpression = ArrayExpression<T> && !std::is_same_v<operand_t<T>, const std::remove_cvref_t<T>&>;
+} // namespace Expressions
+
+template <typename TLhs, typename TRhs>
+    requires Expressions::Operands<TLhs, TRhs>
+auto operator+(const TLhs& lhs, const TRhs& rhs)
+{
+    return Expressions::make_expression<std::plus<>>(lhs, rhs);
+}
+
+template <typename TLhs, typename TRhs>
+    requires Expressions::Operands<TLhs, TRhs>
+auto operator-(const TLhs& lhs, const TRhs& rhs)
+{
+    return Expressions::make_expression<std::minus<>>(lhs, rhs);
+}
+
+template <typename TLhs, typename TRhs>
+    requires Expressions::Operands<TLhs, TRhs>
+auto operator*(const TLhs& lhs, const TRhs& rhs)
+{
+    return Expressions::make_expression<std::multiplies<>>(lhs, rhs);
+}
+
+template <typename TLhs, typename TRhs>
+    requires Expressions::Operands<TLhs, TRhs>
+auto operator/(const TLhs& lhs, const TRhs& rhs)
+{
+    return Expressions::make_expression<std::divides<>>(lhs, rhs);
+}
+
+// reductions use independent partial results per lane, so the loop can be vectorized
+// (the order of floating point additions differs from a plain left-to-right sum)
+template <Expressions::ArrayExpression E>
+auto sum(const E& expr)
+{
+    constexpr size_t n = Expressions::size_v<E>;
+    constexpr size_t lanes = 8;
+    using TValue = std::remove_cvref_t<decltype(expr[0])>;
+
+    TValue partial[lanes] = {};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+        for (size_t lane = 0; lane < lanes; ++lane)
+            partial[lane] += expr[i + lane];
+
+    TValue result = {};
+    for (; i < n; ++i)
+        result += expr[i];
+    for (size_t lane = 0; lane < lanes; ++lane)
+        result += partial[lane];
+
+    return result;
+}
+
+template <Expressions::ArrayExpression E>
+    requires(Expressions::size_v<E> > 0)
+auto max(const E& expr)
+{
+    constexpr size_t n = Expressions::size_v<E>;
+    constexpr size_t lanes = 8;
+    using TValue = std::remove_cvref_t<decltype(expr[0])>;
+
+    if constexpr (n < lanes)
+    {
+        TValue result = expr[0];
+        for (size_t i = 1; i < n; ++i)
+            result = result < expr[i] ? expr[i] : result;
+        return result;
+    }
+    else
+    {
+        TValue partial[lanes];
+        for (size_t lane = 0; lane < lanes; ++lane)
+            partial[lane] = expr[lane];
+
+        size_t i = lanes;
+        for (; i + lanes <= n; i += lanes)
+            for (size_t lane = 0; lane < lanes; ++lane)
+                partial[lane] = partial[lane] < expr[i + lane] ? expr[i + lane] : partial[lane];
+
+        TValue result = partial[0];
+        for (size_t lane = 1; lane < lanes; ++lane)
+            result = result < partial[lane] ? partial[lane] : result;
+        for (; i < n; ++i)
+            result = result < expr[i] ? expr[i] : result;
+
+        return result;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, size_t N>
+struct Array
+{
+    T items[N];
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    size_t size() const
+    {
+        return N;
+    }
+
+    iterator begin()
+    {
+        return items;
+    }
+
+    iterator end()
+    {
+        return items + N;
+    }
+
+    const_iterator begin() const
+    {
+        return items;
+    }
+
+    const_iterator end() const
+    {
+        return items + N;
+    }
+
+    reference operator[](size_t index)
+    {
+        return items[index];
+    }
+
+    const_reference operator[](size_t index) const
+    {
+        return items[index];
+    }
+
+    // evaluation of a lazy expression - a single loop without temporary arrays
+    template <Expressions::LazyExpression E>
+        requires(Expressions::size_v<E> == N)
+    Array& operator=(const E& expr)
+    {
+        for (size_t i = 0; i < N; ++i)
+            items[i] = expr[i];
+
+        return *this;
+    }
+};
+
+template <typename T>
+using Buffer = Array<T, 1024>;
+
+template <typename T>
+using LargeBuffer = Array<T, 2048>;
+
+#endif /*ARRAY_HPP_*/
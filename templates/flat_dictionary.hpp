@@ -0,0 +1,421 @@
+#ifndef FLAT_DICTIONARY_HPP_
+#define FLAT_DICTIONARY_HPP_
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash map with std::string keys - an alternative to Dictionary<T> (std::map<std::string, T>).
+//  * entries are stored contiguously in insertion order (short keys stay inline thanks to SSO)
+//  * iterators yield pair<const key_type&, T&> proxies - keys cannot be modified through them
+//  * slots (linear probing) keep an index of an entry and a fragment of its hash,
+//    so most mismatches are rejected without touching the key
+//  * hashing & comparison are done on std::string_view - lookups never allocate
+//  * erase keeps insertion order, so it is O(n) - the map is tuned for build-once, lookup-often usage
+//  * entries, slots & keys are allocated with TAllocator (keys only when the allocator propagates
+//    to the elements, as std::pmr::polymorphic_allocator does)
+template <typename T, typename TAllocator = std::allocator<T>>
+class FlatDictionary
+{
+    template <typename U>
+    using rebind_alloc = typename std::allocator_traits<TAllocator>::template rebind_alloc<U>;
+
+public:
+    using allocator_type = TAllocator;
+    using key_type = std::basic_string<char, std::char_traits<char>, rebind_alloc<char>>;
+    using mapped_type = T;
+    using value_type = std::pair<key_type, T>;
+    using size_type = size_t;
+
+private:
+    using Entries = std::vector<value_type, rebind_alloc<value_type>>;
+
+    template <bool IsConst>
+    class Iterator
+    {
+        friend class FlatDictionary;
+
+        template <bool>
+        friend class Iterator;
+
+        using EntryIterator = std::conditional_t<IsConst, typename Entries::const_iterator, typename Entries::iterator>;
+
+        EntryIterator entry_{};
+
+        explicit Iterator(EntryIterator entry)
+            : entry_{entry}
+        { }
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // operator* returns a proxy - not a Cpp17 forward iterator
+        using value_type = std::pair<key_type, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const key_type&, std::conditional_t<IsConst, const T&, T&>>;
+
+        // it->second works although the reference is a proxy
+        struct pointer
+        {
+            reference ref;
+
+            const reference* operator->() const
+            {
+                return &ref;
+            }
+        };
+
+        Iterator() = default;
+
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other)
+            : entry_{other.entry_}
+        { }
+
+        reference operator*() const
+        {
+            return reference{entry_->first, entry_->second};
+        }
+
+        pointer operator->() const
+        {
+            return pointer{**this};
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        Iterator& operator++()
+        {
+            ++entry_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        Iterator& operator--()
+        {
+            --entry_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        Iterator& operator+=(difference_type n)
+        {
+            entry_ += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.entry_ - rhs.entry_;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.entry_ == rhs.entry_;
+        }
+
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.entry_ <=> rhs.entry_;
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    struct Slot
+    {
+        uint32_t index = empty_slot;
+        uint32_t hash_fragment = 0;
+    };
+
+    static constexpr uint32_t empty_slot = UINT32_MAX;
+    static constexpr size_t min_capacity = 8;
+
+    Entries entries_;
+    std::vector<Slot, rebind_alloc<Slot>> slots_;
+
+    static size_t hash(std::string_view key)
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    static uint32_t fragment(size_t hash_value)
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(hash_value) >> 32) | 1u;
+    }
+
+    size_t mask() const
+    {
+        return slots_.size() - 1;
+    }
+
+    // slot holding the key or the first empty slot of its probe sequence
+    size_t find_slot(std::string_view key, size_t hash_value) const
+    {
+        const uint32_t frag = fragment(hash_value);
+        size_t pos = hash_value & mask();
+
+        while (true)
+        {
+            const Slot& slot = slots_[pos];
+            if (slot.index == empty_slot)
+                return pos;
+            if (slot.hash_fragment == frag && entries_[slot.index].first == key)
+                return pos;
+
+            pos = (pos + 1) & mask();
+        }
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        slots_.assign(new_capacity, Slot{});
+
+        for (size_t i = 0; i < entries_.size(); ++i)
+        {
+            const size_t hash_value = hash(entries_[i].first);
+            size_t pos = hash_value & mask();
+            while (slots_[pos].index != empty_slot)
+                pos = (pos + 1) & mask();
+
+            slots_[pos] = Slot{static_cast<uint32_t>(i), fragment(hash_value)};
+        }
+    }
+
+    // an existing key is found before growing - a lookup never rehashes
+    // key is a view of key_arg - it is not read after key_arg has been moved
+    template <typename TKey, typename... TArgs>
+    std::pair<iterator, bool> try_emplace_key(std::string_view key, TKey&& key_arg, TArgs&&... args)
+    {
+        const size_t hash_value = hash(key);
+        if (!slots_.empty())
+        {
+            const Slot& slot = slots_[find_slot(key, hash_value)];
+            if (slot.index != empty_slot)
+                return {begin() + slot.index, false};
+        }
+
+        grow_if_needed();
+        Slot& slot = slots_[find_slot(key, hash_value)];
+
+        entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<TKey>(key_arg)),
+            std::forward_as_tuple(std::forward<TArgs>(args)...));
+        slot = Slot{static_cast<uint32_t>(entries_.size() - 1), fragment(hash_value)};
+
+        return {end() - 1, true};
+    }
+
+    void grow_if_needed()
+    {
+        if (slots_.empty())
+            rehash(min_capacity);
+        else if ((entries_.size() + 1) * 4 > slots_.size() * 3) // max load factor 0.75
+            rehash(slots_.size() * 2);
+    }
+
+public:
+    FlatDictionary() = default;
+
+    explicit FlatDictionary(const TAllocator& allocator)
+        : entries_(allocator)
+        , slots_(allocator)
+    { }
+
+    FlatDictionary(std::initializer_list<value_type> items, const TAllocator& allocator = TAllocator())
+        : FlatDictionary(allocator)
+    {
+        reserve(items.size());
+        for (const auto& item : items)
+            insert(item);
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type(entries_.get_allocator());
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    void reserve(size_t count)
+    {
+        entries_.reserve(count);
+
+        size_t capacity = min_capacity;
+        while (count * 4 > capacity * 3)
+            capacity *= 2;
+
+        if (capacity > slots_.size())
+            rehash(capacity);
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        slots_.assign(slots_.size(), Slot{});
+    }
+
+    iterator begin()
+    {
+        return iterator{entries_.begin()};
+    }
+
+    iterator end()
+    {
+        return iterator{entries_.end()};
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{entries_.begin()};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{entries_.end()};
+    }
+
+    iterator find(std::string_view key)
+    {
+        if (entries_.empty())
+            return end();
+
+        const Slot& slot = slots_[find_slot(key, hash(key))];
+        return slot.index == empty_slot ? end() : begin() + slot.index;
+    }
+
+    const_iterator find(std::string_view key) const
+    {
+        return const_cast<FlatDictionary&>(*this).find(key);
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return find(key) != end();
+    }
+
+    size_t count(std::string_view key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    T& at(std::string_view key)
+    {
+        auto pos = find(key);
+        if (pos == end())
+            throw std::out_of_range("FlatDictionary::at - key not found");
+        return pos->second;
+    }
+
+    const T& at(std::string_view key) const
+    {
+        return const_cast<FlatDictionary&>(*this).at(key);
+    }
+
+    template <typename... TArgs>
+    std::pair<iterator, bool> try_emplace(std::string_view key, TArgs&&... args)
+    {
+        return try_emplace_key(key, key, std::forward<TArgs>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& item)
+    {
+        return try_emplace_key(item.first, item.first, item.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& item)
+    {
+        return try_emplace_key(item.first, std::move(item.first), std::move(item.second));
+    }
+
+    template <typename TValue>
+    std::pair<iterator, bool> insert_or_assign(std::string_view key, TValue&& value)
+    {
+        auto result = try_emplace(key, std::forward<TValue>(value));
+        if (!result.second)
+            result.first->second = std::forward<TValue>(value);
+        return result;
+    }
+
+    T& operator[](std::string_view key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    size_t erase(std::string_view key)
+    {
+        auto pos = find(key);
+        if (pos == end())
+            return 0;
+
+        entries_.erase(pos.entry_);
+        rehash(slots_.size()); // indexes of later entries have shifted
+
+        return 1;
+    }
+};
+
+namespace pmr
+{
+    template <typename T>
+    using FlatDictionary = ::FlatDictionary<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+
+#endif /*FLAT_DICTIONARY_HPP_*/
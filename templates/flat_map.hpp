@@ -0,0 +1,480 @@
+#ifndef FLAT_MAP_HPP_
+#define FLAT_MAP_HPP_
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+// Ordered map stored in two sorted vectors (keys & values) - an alternative to std::map
+// for maps that are built once and then mostly searched and scanned in order:
+//  * bulk construction sorts & removes duplicates once (the first occurrence of a key wins - as in std::map)
+//  * searching touches only the keys array, a scan walks two contiguous arrays
+//  * insert & erase of a single item are O(n)
+//  * moves are O(1) - only the vectors' buffers change owners
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class FlatMap
+{
+    std::vector<Key> keys_;
+    std::vector<T> values_;
+    [[no_unique_address]] Compare comp_;
+
+    template <bool IsConst>
+    class Iterator
+    {
+        friend class FlatMap;
+
+        template <bool>
+        friend class Iterator;
+
+        using KeyIterator = typename std::vector<Key>::const_iterator;
+        using ValueIterator = std::conditional_t<IsConst, typename std::vector<T>::const_iterator, typename std::vector<T>::iterator>;
+
+        KeyIterator key_{};
+        ValueIterator value_{};
+
+        Iterator(KeyIterator key, ValueIterator value)
+            : key_{key}
+            , value_{value}
+        { }
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // operator* returns a proxy - not a Cpp17 forward iterator (as in views::zip)
+        using value_type = std::pair<Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<IsConst, const T&, T&>>;
+
+        // it->second works although items are not stored as pairs
+        struct pointer
+        {
+            reference ref;
+
+            const reference* operator->() const
+            {
+                return &ref;
+            }
+        };
+
+        Iterator() = default;
+
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other)
+            : key_{other.key_}
+            , value_{other.value_}
+        { }
+
+        reference operator*() const
+        {
+            return reference{*key_, *value_};
+        }
+
+        pointer operator->() const
+        {
+            return pointer{**this};
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        Iterator& operator++()
+        {
+            ++key_;
+            ++value_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        Iterator& operator--()
+        {
+            --key_;
+            --value_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        Iterator& operator+=(difference_type n)
+        {
+            key_ += n;
+            value_ += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.key_ - rhs.key_;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.key_ == rhs.key_;
+        }
+
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.key_ <=> rhs.key_;
+        }
+    };
+
+    static constexpr bool is_transparent_v = requires { typename Compare::is_transparent; };
+
+    // with a non-transparent comparator the key is converted once - not in every comparison
+    template <typename K>
+    static decltype(auto) lookup_key(const K& key)
+    {
+        if constexpr (is_transparent_v || std::is_same_v<K, Key>)
+            return (key);
+        else
+            return Key(key);
+    }
+
+    template <typename K>
+    size_t lower_bound_index(const K& key) const
+    {
+        const auto& lookup = lookup_key(key);
+        return std::lower_bound(keys_.begin(), keys_.end(), lookup, comp_) - keys_.begin();
+    }
+
+    template <typename K>
+    size_t upper_bound_index(const K& key) const
+    {
+        const auto& lookup = lookup_key(key);
+        return std::upper_bound(keys_.begin(), keys_.end(), lookup, comp_) - keys_.begin();
+    }
+
+    template <typename K>
+    size_t find_index(const K& key) const
+    {
+        const auto& lookup = lookup_key(key);
+        const size_t index = std::lower_bound(keys_.begin(), keys_.end(), lookup, comp_) - keys_.begin();
+        return index != keys_.size() && !comp_(lookup, keys_[index]) ? index : keys_.size();
+    }
+
+    template <typename InputIterator>
+    void build(InputIterator first, InputIterator last)
+    {
+        std::vector<std::pair<Key, T>> items(first, last);
+
+        auto key_less = [this](const auto& a, const auto& b) { return comp_(a.first, b.first); };
+        auto key_equal = [this](const auto& a, const auto& b) { return !comp_(a.first, b.first) && !comp_(b.first, a.first); };
+
+        std::stable_sort(items.begin(), items.end(), key_less);
+        items.erase(std::unique(items.begin(), items.end(), key_equal), items.end());
+
+        keys_.reserve(items.size());
+        values_.reserve(items.size());
+        for (auto& [key, value] : items)
+        {
+            keys_.push_back(std::move(key));
+            values_.push_back(std::move(value));
+        }
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    template <typename K>
+    static constexpr bool is_lookup_key_v = is_transparent_v || std::is_constructible_v<Key, const K&>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_{comp}
+    { }
+
+    template <std::input_iterator InputIterator>
+    FlatMap(InputIterator first, InputIterator last, const Compare& comp = Compare{})
+        : comp_{comp}
+    {
+        build(first, last);
+    }
+
+    FlatMap(std::initializer_list<value_type> items, const Compare& comp = Compare{})
+        : FlatMap(items.begin(), items.end(), comp)
+    { }
+
+    // adopts arrays that are already sorted by comp and free of duplicates - O(1)
+    FlatMap(sorted_unique_t, std::vector<Key> keys, std::vector<T> values, const Compare& comp = Compare{})
+        : keys_{std::move(keys)}
+        , values_{std::move(values)}
+        , comp_{comp}
+    {
+        if (keys_.size() != values_.size())
+            throw std::invalid_argument("FlatMap - sizes of keys and values differ");
+    }
+
+    size_t size() const
+    {
+        return keys_.size();
+    }
+
+    bool empty() const
+    {
+        return keys_.empty();
+    }
+
+    void reserve(size_t count)
+    {
+        keys_.reserve(count);
+        values_.reserve(count);
+    }
+
+    void clear()
+    {
+        keys_.clear();
+        values_.clear();
+    }
+
+    key_compare key_comp() const
+    {
+        return comp_;
+    }
+
+    const std::vector<Key>& keys() const
+    {
+        return keys_;
+    }
+
+    const std::vector<T>& values() const
+    {
+        return values_;
+    }
+
+    iterator begin()
+    {
+        return iterator{keys_.cbegin(), values_.begin()};
+    }
+
+    iterator end()
+    {
+        return iterator{keys_.cend(), values_.end()};
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{keys_.cbegin(), values_.cbegin()};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{keys_.cend(), values_.cend()};
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    iterator find(const K& key)
+    {
+        return begin() + find_index(key);
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    const_iterator find(const K& key) const
+    {
+        return begin() + find_index(key);
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    bool contains(const K& key) const
+    {
+        return find_index(key) != size();
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    size_t count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    // first item not ordered before the key
+    template <typename K>
+        requires is_lookup_key_v<K>
+    iterator lower_bound(const K& key)
+    {
+        return begin() + lower_bound_index(key);
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    const_iterator lower_bound(const K& key) const
+    {
+        return begin() + lower_bound_index(key);
+    }
+
+    // first item ordered after the key
+    template <typename K>
+        requires is_lookup_key_v<K>
+    iterator upper_bound(const K& key)
+    {
+        return begin() + upper_bound_index(key);
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    const_iterator upper_bound(const K& key) const
+    {
+        return begin() + upper_bound_index(key);
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    T& at(const K& key)
+    {
+        const size_t index = find_index(key);
+        if (index == size())
+            throw std::out_of_range("FlatMap::at - key not found");
+        return values_[index];
+    }
+
+    template <typename K>
+        requires is_lookup_key_v<K>
+    const T& at(const K& key) const
+    {
+        return const_cast<FlatMap&>(*this).at(key);
+    }
+
+    template <typename K, typename... TArgs>
+    std::pair<iterator, bool> try_emplace(K&& key, TArgs&&... args)
+    {
+        const size_t index = lower_bound_index(key);
+        if (index != size() && !comp_(key, keys_[index]))
+            return {begin() + index, false};
+
+        keys_.emplace(keys_.begin() + index, std::forward<K>(key));
+        try
+        {
+            values_.emplace(values_.begin() + index, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            keys_.erase(keys_.begin() + index);
+            throw;
+        }
+
+        return {begin() + index, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& item)
+    {
+        return try_emplace(item.first, item.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& item)
+    {
+        return try_emplace(std::move(item.first), std::move(item.second));
+    }
+
+    template <typename K, typename TValue>
+    std::pair<iterator, bool> insert_or_assign(K&& key, TValue&& value)
+    {
+        auto result = try_emplace(std::forward<K>(key), std::forward<TValue>(value));
+        if (!result.second)
+            result.first->second = std::forward<TValue>(value);
+        return result;
+    }
+
+    T& operator[](const Key& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    T& operator[](Key&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        const auto index = pos - cbegin();
+        keys_.erase(keys_.begin() + index);
+        values_.erase(values_.begin() + index);
+        return begin() + index;
+    }
+
+    template <typename K>
+        requires(is_lookup_key_v<K> && !std::is_convertible_v<const K&, const_iterator>)
+    size_t erase(const K& key)
+    {
+        const size_t index = find_index(key);
+        if (index == size())
+            return 0;
+
+        erase(cbegin() + index);
+        return 1;
+    }
+};
+
+#endif /*FLAT_MAP_HPP_*/
@@ -0,0 +1,139 @@
+#ifndef FORMAT_UTILS_HPP_
+#define FORMAT_UTILS_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Allocation-free formatting of values with std::to_chars (<format> is not shipped with GCC 12).
+// Output is the same as from operator<< with default stream flags - floating points use
+// the general format with precision 6. Other types are left to streams.
+namespace Formatting
+{
+    template <typename T>
+    concept Numeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+        && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>
+        && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+    template <typename T>
+    concept StringLike = std::is_same_v<T, char> || std::is_convertible_v<const T&, std::string_view>;
+
+    template <typename T>
+    concept Formattable = Numeric<T> || StringLike<T>;
+
+    // upper bound of characters written for a numeric value
+    template <Numeric T>
+    constexpr size_t max_chars_v = std::is_floating_point_v<T>
+        ? 6 + 8 + 2 // significant digits, exponent (e-4931 for long double) and a sign with a decimal point
+        : std::numeric_limits<T>::digits10 + 2;
+
+    namespace Details
+    {
+        template <Numeric T>
+        std::to_chars_result numeric_to_chars(char* first, char* last, T value)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return std::to_chars(first, last, value, std::chars_format::general, 6);
+            else
+                return std::to_chars(first, last, value);
+        }
+
+        template <typename T>
+        std::string_view as_string_view(const T& value)
+        {
+            if constexpr (std::is_same_v<T, char>)
+                return std::string_view{&value, 1};
+            else
+                return std::string_view{value};
+        }
+
+        inline std::to_chars_result copy_chars(char* first, char* last, std::string_view text)
+        {
+            if (static_cast<size_t>(last - first) < text.size())
+                return {last, std::errc::value_too_large};
+            return {std::copy(text.begin(), text.end(), first), std::errc{}};
+        }
+    } // namespace Details
+
+    // writes the value into [first, last) - the same contract as std::to_chars
+    template <Formattable T>
+    std::to_chars_result to_chars(char* first, char* last, const T& value)
+    {
+        if constexpr (Numeric<T>)
+            return Details::numeric_to_chars(first, last, value);
+        else
+            return Details::copy_chars(first, last, Details::as_string_view(value));
+    }
+
+    template <typename OutputIt, Formattable T>
+    OutputIt format_to(OutputIt out, const T& value)
+    {
+        if constexpr (Numeric<T>)
+        {
+            char buffer[max_chars_v<T>];
+            const auto [end, ec] = Details::numeric_to_chars(buffer, buffer + sizeof(buffer), value);
+            return std::copy(buffer, end, out);
+        }
+        else
+        {
+            const std::string_view text = Details::as_string_view(value);
+            return std::copy(text.begin(), text.end(), out);
+        }
+    }
+
+    // "[ first, second]" - the format used by ValuePair
+    template <typename OutputIt, Formattable T1, Formattable T2>
+    OutputIt format_pair_to(OutputIt out, const T1& first, const T2& second)
+    {
+        out = format_to(out, std::string_view{"[ "});
+        out = format_to(out, first);
+        out = format_to(out, std::string_view{", "});
+        out = format_to(out, second);
+        return format_to(out, std::string_view{"]"});
+    }
+
+    template <Formattable T1, Formattable T2>
+    std::to_chars_result pair_to_chars(char* first, char* last, const T1& fst, const T2& snd)
+    {
+        std::to_chars_result result{first, std::errc{}};
+
+        auto write = [&](const auto& value) {
+            if (result.ec == std::errc{})
+                result = to_chars(result.ptr, last, value);
+        };
+
+        write(std::string_view{"[ "});
+        write(fst);
+        write(std::string_view{", "});
+        write(snd);
+        write(std::string_view{"]"});
+
+        return result;
+    }
+
+    template <Formattable T1, Formattable T2>
+    std::string pair_to_string(const T1& first, const T2& second)
+    {
+        if constexpr (Numeric<T1> && Numeric<T2>)
+        {
+            // formatted on the stack - the only allocation is made by std::string (none when SSO fits)
+            char buffer[max_chars_v<T1> + max_chars_v<T2> + 5];
+            const auto [end, ec] = pair_to_chars(buffer, buffer + sizeof(buffer), first, second);
+            return std::string(buffer, end);
+        }
+        else
+        {
+            std::string result;
+            format_pair_to(std::back_inserter(result), first, second);
+            return result;
+        }
+    }
+} // namespace Formatting
+
+#endif /*FORMAT_UTILS_HPP_*/
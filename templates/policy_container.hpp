@@ -0,0 +1,390 @@
+#ifndef POLICY_CONTAINER_HPP_
+#define POLICY_CONTAINER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Policy Based Design - storage, locking & growth strategies of a Container are chosen
+// with template parameters, so every call is resolved (and usually inlined) at compile time.
+
+namespace StoragePolicies
+{
+    // a storage policy provides: template <typename T> Storage
+    // with emplace_back, pop_back, back, operator[], size, begin, end & clear
+    // (reserve & capacity are optional - growth policies are applied only to storages that have them)
+
+    struct Vector
+    {
+        static constexpr std::string_view name = "vector";
+
+        template <typename T>
+        using Storage = std::vector<T>;
+    };
+
+    struct Deque
+    {
+        static constexpr std::string_view name = "deque";
+
+        template <typename T>
+        using Storage = std::deque<T>;
+    };
+
+    // first N items are stored inside of the container - the heap is used only when it grows beyond N
+    template <size_t N>
+    struct Inline
+    {
+        static constexpr std::string_view name = "inline";
+
+        template <typename T>
+        class Storage
+        {
+            alignas(T) std::byte buffer_[N * sizeof(T)];
+            T* data_ = reinterpret_cast<T*>(buffer_);
+            size_t size_ = 0;
+            size_t capacity_ = N;
+
+            bool is_inline() const
+            {
+                return data_ == reinterpret_cast<const T*>(buffer_);
+            }
+
+        public:
+            Storage() = default;
+            Storage(const Storage&) = delete;
+            Storage& operator=(const Storage&) = delete;
+
+            ~Storage()
+            {
+                clear();
+                if (!is_inline())
+                    std::allocator<T>{}.deallocate(data_, capacity_);
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            size_t capacity() const
+            {
+                return capacity_;
+            }
+
+            void reserve(size_t new_capacity)
+            {
+                if (new_capacity <= capacity_)
+                    return;
+
+                T* new_data = std::allocator<T>{}.allocate(new_capacity);
+                try
+                {
+                    std::uninitialized_move(data_, data_ + size_, new_data);
+                }
+                catch (...)
+                {
+                    std::allocator<T>{}.deallocate(new_data, new_capacity);
+                    throw;
+                }
+
+                std::destroy(data_, data_ + size_);
+                if (!is_inline())
+                    std::allocator<T>{}.deallocate(data_, capacity_);
+
+                data_ = new_data;
+                capacity_ = new_capacity;
+            }
+
+            template <typename... TArgs>
+            T& emplace_back(TArgs&&... args)
+            {
+                if (size_ == capacity_)
+                    reserve(2 * capacity_);
+
+                T* item = std::construct_at(data_ + size_, std::forward<TArgs>(args)...);
+                ++size_;
+                return *item;
+            }
+
+            void pop_back()
+            {
+                std::destroy_at(data_ + --size_);
+            }
+
+            T& back()
+            {
+                return data_[size_ - 1];
+            }
+
+            T& operator[](size_t index)
+            {
+                return data_[index];
+            }
+
+            const T& operator[](size_t index) const
+            {
+                return data_[index];
+            }
+
+            T* begin()
+            {
+                return data_;
+            }
+
+            T* end()
+            {
+                return data_ + size_;
+            }
+
+            const T* begin() const
+            {
+                return data_;
+            }
+
+            const T* end() const
+            {
+                return data_ + size_;
+            }
+
+            void clear()
+            {
+                std::destroy(data_, data_ + size_);
+                size_ = 0;
+            }
+        };
+    };
+} // namespace StoragePolicies
+
+namespace LockingPolicies
+{
+    // a locking policy meets the SharedLockable requirements - readers use lock_shared()
+
+    struct None
+    {
+        static constexpr std::string_view name = "no locking";
+
+        void lock() { }
+        void unlock() { }
+        void lock_shared() { }
+        void unlock_shared() { }
+    };
+
+    struct Mutex : std::mutex
+    {
+        static constexpr std::string_view name = "std::mutex";
+
+        void lock_shared()
+        {
+            lock();
+        }
+
+        void unlock_shared()
+        {
+            unlock();
+        }
+    };
+
+    class Spinlock
+    {
+        std::atomic<bool> is_locked_{false};
+
+    public:
+        static constexpr std::string_view name = "spinlock";
+
+        void lock()
+        {
+            while (is_locked_.exchange(true, std::memory_order_acquire))
+            {
+                // spin on a read (no cache line ping-pong), give the core away when the holder was preempted
+                for (int i = 0; is_locked_.load(std::memory_order_relaxed); ++i)
+                {
+                    if (i >= 64)
+                        std::this_thread::yield();
+                }
+            }
+        }
+
+        void unlock()
+        {
+            is_locked_.store(false, std::memory_order_release);
+        }
+
+        void lock_shared()
+        {
+            lock();
+        }
+
+        void unlock_shared()
+        {
+            unlock();
+        }
+    };
+
+    struct ReaderWriter : std::shared_mutex
+    {
+        static constexpr std::string_view name = "std::shared_mutex";
+    };
+} // namespace LockingPolicies
+
+namespace GrowthPolicies
+{
+    // a growth policy calculates a new capacity of a full storage
+
+    struct Factor1_5
+    {
+        static constexpr std::string_view name = "1.5x";
+
+        static constexpr size_t next_capacity(size_t capacity, size_t required)
+        {
+            return std::max({required, capacity + capacity / 2, size_t{8}});
+        }
+    };
+
+    struct Factor2
+    {
+        static constexpr std::string_view name = "2x";
+
+        static constexpr size_t next_capacity(size_t capacity, size_t required)
+        {
+            return std::max({required, 2 * capacity, size_t{8}});
+        }
+    };
+
+    template <size_t ChunkSize>
+    struct Chunks
+    {
+        static_assert(ChunkSize > 0);
+
+        static constexpr std::string_view name = "chunks";
+
+        static constexpr size_t next_capacity(size_t, size_t required)
+        {
+            return (required + ChunkSize - 1) / ChunkSize * ChunkSize;
+        }
+    };
+} // namespace GrowthPolicies
+
+template <typename T,
+    typename TStoragePolicy = StoragePolicies::Vector,
+    typename TLockingPolicy = LockingPolicies::None,
+    typename TGrowthPolicy = GrowthPolicies::Factor2>
+class Container
+{
+    using Storage = typename TStoragePolicy::template Storage<T>;
+
+    Storage storage_;
+    [[no_unique_address]] mutable TLockingPolicy mtx_;
+
+    static constexpr bool has_capacity = requires(Storage& storage) {
+        storage.capacity();
+        storage.reserve(size_t{});
+    };
+
+    void grow_if_full()
+    {
+        if constexpr (has_capacity)
+        {
+            if (storage_.size() == storage_.capacity())
+                storage_.reserve(TGrowthPolicy::next_capacity(storage_.capacity(), storage_.size() + 1));
+        }
+    }
+
+public:
+    using value_type = T;
+    using storage_policy = TStoragePolicy;
+    using locking_policy = TLockingPolicy;
+    using growth_policy = TGrowthPolicy;
+
+    Container() = default;
+    Container(const Container&) = delete;
+    Container& operator=(const Container&) = delete;
+
+    template <typename... TArgs>
+    void emplace_back(TArgs&&... args)
+    {
+        std::unique_lock lk{mtx_};
+        grow_if_full();
+        storage_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    bool try_pop_back(T& item)
+    {
+        std::unique_lock lk{mtx_};
+        if (storage_.size() == 0)
+            return false;
+
+        item = std::move(storage_.back());
+        storage_.pop_back();
+        return true;
+    }
+
+    // returns a copy - a reference would outlive the lock
+    T at(size_t index) const
+    {
+        std::shared_lock lk{mtx_};
+        if (index >= storage_.size())
+            throw std::out_of_range("Container::at - index out of range");
+        return storage_[index];
+    }
+
+    // visits all items holding a shared lock
+    template <typename TFunction>
+    void for_each(TFunction f) const
+    {
+        std::shared_lock lk{mtx_};
+        for (const auto& item : storage_)
+            f(item);
+    }
+
+    size_t size() const
+    {
+        std::shared_lock lk{mtx_};
+        return storage_.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t capacity() const
+        requires has_capacity
+    {
+        std::shared_lock lk{mtx_};
+        return storage_.capacity();
+    }
+
+    void reserve(size_t new_capacity)
+        requires has_capacity
+    {
+        std::unique_lock lk{mtx_};
+        storage_.reserve(new_capacity);
+    }
+
+    void clear()
+    {
+        std::unique_lock lk{mtx_};
+        storage_.clear();
+    }
+};
+
+#endif /*POLICY_CONTAINER_HPP_*/
@@ -0,0 +1,325 @@
+#ifndef RELOCATING_VECTOR_HPP_
+#define RELOCATING_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// A type is trivially relocatable when moving an object to a new address and destroying
+// the source is equivalent to copying its bytes (and forgetting the source).
+// Types opt in with a member alias:
+//     using is_trivially_relocatable = std::true_type;
+// or with a specialization of the trait. Types with pointers into themselves
+// (e.g. std::string with SSO in libstdc++) must not opt in.
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T> || requires { requires T::is_trivially_relocatable::value; }>
+{ };
+
+// std::unique_ptr & std::shared_ptr hold only pointers (and an empty deleter) in libstdc++, libc++ and MSVC STL
+template <typename T, typename TDeleter>
+struct is_trivially_relocatable<std::unique_ptr<T, TDeleter>> : is_trivially_relocatable<TDeleter>
+{ };
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+{ };
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// vector-like container that moves trivially relocatable items with memcpy/memmove
+// when it grows or closes a gap after erase - no move constructor & destructor call per item
+template <typename T>
+class RelocatingVector
+{
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    static T* allocate(size_t count)
+    {
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    static void deallocate(T* ptr, size_t count)
+    {
+        if (ptr)
+            std::allocator<T>{}.deallocate(ptr, count);
+    }
+
+    // moves all items to new_data - leaves the old buffer without alive objects
+    void relocate_to(T* new_data)
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (size_)
+                std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+        }
+        else
+        {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                std::uninitialized_move(data_, data_ + size_, new_data);
+            else
+                std::uninitialized_copy(data_, data_ + size_, new_data); // strong guarantee for throwing moves
+            std::destroy(data_, data_ + size_);
+        }
+    }
+
+    size_t next_capacity() const
+    {
+        return capacity_ ? 2 * capacity_ : 8;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+
+    RelocatingVector() = default;
+
+    RelocatingVector(std::initializer_list<T> items)
+        requires std::is_copy_constructible_v<T>
+    {
+        reserve(items.size());
+        for (const auto& item : items)
+            push_back(item);
+    }
+
+    RelocatingVector(const RelocatingVector& other)
+        requires std::is_copy_constructible_v<T>
+    {
+        reserve(other.size_);
+        for (const auto& item : other)
+            push_back(item);
+    }
+
+    RelocatingVector& operator=(const RelocatingVector& other)
+        requires std::is_copy_constructible_v<T>
+    {
+        RelocatingVector temp(other);
+        swap(temp);
+        return *this;
+    }
+
+    RelocatingVector(RelocatingVector&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}
+        , size_{std::exchange(other.size_, 0)}
+        , capacity_{std::exchange(other.capacity_, 0)}
+    { }
+
+    RelocatingVector& operator=(RelocatingVector&& other) noexcept
+    {
+        RelocatingVector temp(std::move(other));
+        swap(temp);
+        return *this;
+    }
+
+    ~RelocatingVector()
+    {
+        clear();
+        deallocate(data_, capacity_);
+    }
+
+    void swap(RelocatingVector& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity_)
+            return;
+
+        T* new_data = allocate(new_capacity);
+        try
+        {
+            relocate_to(new_data);
+        }
+        catch (...)
+        {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ < capacity_)
+            return *std::construct_at(data_ + size_++, std::forward<TArgs>(args)...);
+
+        // the new item is constructed before relocation - args may refer to items of this vector
+        const size_t new_capacity = next_capacity();
+        T* new_data = allocate(new_capacity);
+        try
+        {
+            std::construct_at(new_data + size_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            relocate_to(new_data);
+        }
+        catch (...)
+        {
+            std::destroy_at(new_data + size_);
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+
+        return data_[size_++];
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(data_ + --size_);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* gap_begin = data_ + (first - data_);
+        T* gap_end = data_ + (last - data_);
+        const size_t gap_size = gap_end - gap_begin;
+
+        if (gap_size == 0)
+            return gap_begin;
+
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::destroy(gap_begin, gap_end);
+            std::memmove(static_cast<void*>(gap_begin), static_cast<const void*>(gap_end), (data_ + size_ - gap_end) * sizeof(T));
+        }
+        else
+        {
+            std::move(gap_end, data_ + size_, gap_begin);
+            std::destroy(data_ + size_ - gap_size, data_ + size_);
+        }
+
+        size_ -= gap_size;
+
+        return gap_begin;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    void clear()
+    {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    T& operator[](size_t index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data_[index];
+    }
+
+    T& at(size_t index)
+    {
+        if (index >= size_)
+            throw std::out_of_range("RelocatingVector::at - index out of range");
+        return data_[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        return const_cast<RelocatingVector&>(*this).at(index);
+    }
+
+    T& front()
+    {
+        return data_[0];
+    }
+
+    T& back()
+    {
+        return data_[size_ - 1];
+    }
+
+    T* data()
+    {
+        return data_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    iterator begin()
+    {
+        return data_;
+    }
+
+    iterator end()
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const
+    {
+        return data_;
+    }
+
+    const_iterator end() const
+    {
+        return data_ + size_;
+    }
+};
+
+#endif /*RELOCATING_VECTOR_HPP_*/
@@ -0,0 +1,188 @@
+#ifndef SIMD_FIND_HPP_
+#define SIMD_FIND_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_FIND_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SIMD_FIND_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_FIND_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Simd
+{
+    // types for which a bitwise lane compare gives the same answer as operator==
+    template <typename T>
+    constexpr bool is_searchable_v = (std::is_integral_v<T> && !std::is_same_v<T, bool>
+                                         && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    namespace Detail
+    {
+        template <typename T>
+        const T* find_scalar(const T* first, const T* last, T value)
+        {
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+
+            return last;
+        }
+
+        inline unsigned count_trailing_zeros(unsigned mask)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctz(mask);
+#else
+            unsigned count = 0;
+            while ((mask & 1u) == 0)
+            {
+                mask >>= 1;
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+#ifdef SIMD_FIND_SSE2
+        template <typename T>
+        __m128i broadcast_sse2(T value)
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return _mm_castps_si128(_mm_set1_ps(value));
+            else if constexpr (std::is_same_v<T, double>)
+                return _mm_castpd_si128(_mm_set1_pd(value));
+            else if constexpr (sizeof(T) == 1)
+                return _mm_set1_epi8(static_cast<char>(value));
+            else if constexpr (sizeof(T) == 2)
+                return _mm_set1_epi16(static_cast<short>(value));
+            else if constexpr (sizeof(T) == 4)
+                return _mm_set1_epi32(static_cast<int>(value));
+            else
+                return _mm_set1_epi64x(static_cast<long long>(value));
+        }
+
+        // one bit per byte of every lane equal to the needle
+        template <typename T>
+        unsigned match_mask_sse2(__m128i block, __m128i needle)
+        {
+            __m128i eq;
+
+            if constexpr (std::is_same_v<T, float>)
+                eq = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+            else if constexpr (std::is_same_v<T, double>)
+                eq = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+            else if constexpr (sizeof(T) == 1)
+                eq = _mm_cmpeq_epi8(block, needle);
+            else if constexpr (sizeof(T) == 2)
+                eq = _mm_cmpeq_epi16(block, needle);
+            else if constexpr (sizeof(T) == 4)
+                eq = _mm_cmpeq_epi32(block, needle);
+            else
+            {
+                // no 64-bit compare in SSE2 - both 32-bit halves have to match
+                __m128i eq32 = _mm_cmpeq_epi32(block, needle);
+                eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+
+            return static_cast<unsigned>(_mm_movemask_epi8(eq));
+        }
+
+        template <typename T>
+        const T* find_sse2(const T* first, const T* last, T value)
+        {
+            constexpr size_t lanes = sizeof(__m128i) / sizeof(T);
+            const __m128i needle = broadcast_sse2(value);
+
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                if (unsigned mask = match_mask_sse2<T>(block, needle))
+                    return first + count_trailing_zeros(mask) / sizeof(T);
+            }
+
+            return find_scalar(first, last, value);
+        }
+#endif
+
+#ifdef SIMD_FIND_AVX2
+        template <typename T>
+        __attribute__((target("avx2"))) const T* find_avx2(const T* first, const T* last, T value)
+        {
+            constexpr size_t lanes = sizeof(__m256i) / sizeof(T);
+
+            __m256i needle;
+            if constexpr (std::is_same_v<T, float>)
+                needle = _mm256_castps_si256(_mm256_set1_ps(value));
+            else if constexpr (std::is_same_v<T, double>)
+                needle = _mm256_castpd_si256(_mm256_set1_pd(value));
+            else if constexpr (sizeof(T) == 1)
+                needle = _mm256_set1_epi8(static_cast<char>(value));
+            else if constexpr (sizeof(T) == 2)
+                needle = _mm256_set1_epi16(static_cast<short>(value));
+            else if constexpr (sizeof(T) == 4)
+                needle = _mm256_set1_epi32(static_cast<int>(value));
+            else
+                needle = _mm256_set1_epi64x(static_cast<long long>(value));
+
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i eq;
+
+                if constexpr (std::is_same_v<T, float>)
+                    eq = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+                else if constexpr (std::is_same_v<T, double>)
+                    eq = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+                else if constexpr (sizeof(T) == 1)
+                    eq = _mm256_cmpeq_epi8(block, needle);
+                else if constexpr (sizeof(T) == 2)
+                    eq = _mm256_cmpeq_epi16(block, needle);
+                else if constexpr (sizeof(T) == 4)
+                    eq = _mm256_cmpeq_epi32(block, needle);
+                else
+                    eq = _mm256_cmpeq_epi64(block, needle);
+
+                if (unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(eq)))
+                    return first + count_trailing_zeros(mask) / sizeof(T);
+            }
+
+            return find_sse2(first, last, value);
+        }
+
+        inline bool cpu_has_avx2()
+        {
+            static const bool has_avx2 = __builtin_cpu_supports("avx2");
+            return has_avx2;
+        }
+#endif
+    } // namespace Detail
+
+    // vectorized linear search - SSE2 baseline, AVX2 when the CPU supports it
+    template <typename T>
+    const T* find(const T* first, const T* last, T value)
+    {
+        static_assert(is_searchable_v<T>);
+
+#if defined(SIMD_FIND_AVX2)
+        if (Detail::cpu_has_avx2())
+            return Detail::find_avx2(first, last, value);
+#endif
+
+#if defined(SIMD_FIND_SSE2)
+        return Detail::find_sse2(first, last, value);
+#else
+        return Detail::find_scalar(first, last, value);
+#endif
+    }
+} // namespace Simd
+
+#endif /*SIMD_FIND_HPP_*/
@@ -0,0 +1,134 @@
+#ifndef SPSC_QUEUE_HPP_
+#define SPSC_QUEUE_HPP_
+
+#include "array.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Lock-free ring queue for exactly one producer thread and one consumer thread.
+// Slots live in an Array<T, Capacity>, so T has to be default constructible and move assignable.
+// Indexes grow monotonically and are mapped on slots with a mask (Capacity is a power of two).
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>);
+
+    static constexpr size_t mask = Capacity - 1;
+    static constexpr size_t cache_line = 64;
+
+    // producer's cache line - tail is written by the producer, cached_head_ is its private copy of head_
+    alignas(cache_line) std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};
+
+    // consumer's cache line
+    alignas(cache_line) std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};
+
+    alignas(cache_line) Array<T, Capacity> items_{};
+
+    // the other side's index is re-read only when the cached copy does not promise enough room/items
+    size_t free_slots(size_t tail, size_t wanted)
+    {
+        if (Capacity - (tail - cached_head_) < wanted)
+            cached_head_ = head_.load(std::memory_order_acquire);
+
+        return Capacity - (tail - cached_head_);
+    }
+
+    size_t ready_items(size_t head, size_t wanted)
+    {
+        if (cached_tail_ - head < wanted)
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+
+        return cached_tail_ - head;
+    }
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+    // producer side
+
+    template <typename U>
+    bool try_push(U&& item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (free_slots(tail, 1) == 0)
+            return false;
+
+        items_[tail & mask] = std::forward<U>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // pushes up to count items - returns how many were pushed (pass move iterators to move items in)
+    template <typename InputIterator>
+    size_t push_n(InputIterator first, size_t count)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t pushed = std::min(count, free_slots(tail, count));
+
+        for (size_t i = 0; i < pushed; ++i, ++first)
+            items_[(tail + i) & mask] = *first;
+
+        tail_.store(tail + pushed, std::memory_order_release); // one publication for the whole batch
+
+        return pushed;
+    }
+
+    // consumer side
+
+    bool try_pop(T& item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (ready_items(head, 1) == 0)
+            return false;
+
+        item = std::move(items_[head & mask]);
+        head_.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // pops up to max_count items - returns how many were popped
+    template <typename OutputIterator>
+    size_t pop_n(OutputIterator out, size_t max_count)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t popped = std::min(max_count, ready_items(head, max_count));
+
+        for (size_t i = 0; i < popped; ++i, ++out)
+            *out = std::move(items_[(head + i) & mask]);
+
+        head_.store(head + popped, std::memory_order_release);
+
+        return popped;
+    }
+
+    // approximate when called concurrently
+    size_t size() const
+    {
+        const size_t head = head_.load(std::memory_order_acquire); // head first - it never passes tail
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+};
+
+#endif /*SPSC_QUEUE_HPP_*/
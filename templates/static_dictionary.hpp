@@ -0,0 +1,180 @@
+#ifndef STATIC_DICTIONARY_HPP_
+#define STATIC_DICTIONARY_HPP_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+// Read-only string -> string map built by a constexpr perfect hash generator
+// (hash & displace: keys are split into buckets and every bucket gets a seed
+// that places all its keys in free slots). A lookup is two hashes and one key compare.
+namespace StaticDictionaryDetails
+{
+    constexpr uint64_t hash(std::string_view key, uint64_t seed)
+    {
+        uint64_t h = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull); // FNV-1a with a seeded basis
+        for (char c : key)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+
+        h ^= h >> 33; // final avalanche - FNV alone mixes the last characters poorly
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+
+        return h;
+    }
+
+    struct Entry
+    {
+        std::string_view first;
+        std::string_view second;
+        bool used = false;
+    };
+} // namespace StaticDictionaryDetails
+
+template <size_t N>
+class StaticDictionary
+{
+    static_assert(N > 0);
+
+public:
+    static constexpr size_t bucket_count = N;
+    static constexpr size_t slot_count = std::bit_ceil(N + N / 4 + 1);
+
+    using Entry = StaticDictionaryDetails::Entry;
+    using const_iterator = const Entry*;
+
+private:
+    std::array<uint32_t, bucket_count> seeds_{};
+    std::array<Entry, slot_count> slots_{};
+
+    static constexpr size_t bucket_of(std::string_view key)
+    {
+        return StaticDictionaryDetails::hash(key, 0) % bucket_count;
+    }
+
+    static constexpr size_t slot_of(std::string_view key, uint32_t seed)
+    {
+        return StaticDictionaryDetails::hash(key, seed) & (slot_count - 1);
+    }
+
+public:
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    constexpr explicit StaticDictionary(const value_type (&items)[N])
+    {
+        std::array<size_t, N> item_buckets{};
+        std::array<size_t, bucket_count> bucket_sizes{};
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (items[i].first == items[j].first)
+                    throw std::invalid_argument("StaticDictionary - duplicated key");
+            }
+
+            item_buckets[i] = bucket_of(items[i].first);
+            ++bucket_sizes[item_buckets[i]];
+        }
+
+        // largest buckets are placed first, while most slots are still free
+        std::array<size_t, bucket_count> order{};
+        for (size_t b = 0; b < bucket_count; ++b)
+            order[b] = b;
+        for (size_t i = 1; i < bucket_count; ++i)
+        {
+            for (size_t j = i; j > 0 && bucket_sizes[order[j - 1]] < bucket_sizes[order[j]]; --j)
+            {
+                const size_t temp = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = temp;
+            }
+        }
+
+        for (size_t b : order)
+        {
+            if (bucket_sizes[b] == 0)
+                break;
+
+            std::array<size_t, N> members{};
+            for (size_t i = 0, k = 0; i < N; ++i)
+            {
+                if (item_buckets[i] == b)
+                    members[k++] = i;
+            }
+
+            for (uint32_t seed = 1;; ++seed)
+            {
+                if (seed == 1'000'000)
+                    throw std::logic_error("StaticDictionary - perfect hash not found");
+
+                std::array<size_t, N> taken{};
+                bool placed = true;
+
+                for (size_t k = 0; k < bucket_sizes[b] && placed; ++k)
+                {
+                    const size_t slot = slot_of(items[members[k]].first, seed);
+                    placed = !slots_[slot].used;
+                    for (size_t prev = 0; prev < k && placed; ++prev)
+                        placed = taken[prev] != slot;
+                    taken[k] = slot;
+                }
+
+                if (!placed)
+                    continue;
+
+                for (size_t k = 0; k < bucket_sizes[b]; ++k)
+                {
+                    const auto& item = items[members[k]];
+                    slots_[taken[k]] = Entry{item.first, item.second, true};
+                }
+                seeds_[b] = seed;
+                break;
+            }
+        }
+    }
+
+    static constexpr size_t size()
+    {
+        return N;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return slots_.data() + slot_count;
+    }
+
+    constexpr const_iterator find(std::string_view key) const
+    {
+        const Entry& entry = slots_[slot_of(key, seeds_[bucket_of(key)])];
+        return entry.used && entry.first == key ? &entry : end();
+    }
+
+    constexpr bool contains(std::string_view key) const
+    {
+        return find(key) != end();
+    }
+
+    constexpr std::string_view at(std::string_view key) const
+    {
+        const_iterator pos = find(key);
+        if (pos == end())
+            throw std::out_of_range("StaticDictionary::at - key not found");
+        return pos->second;
+    }
+};
+
+template <size_t N>
+constexpr StaticDictionary<N> make_static_dictionary(const std::pair<std::string_view, std::string_view> (&items)[N])
+{
+    return StaticDictionary<N>{items};
+}
+
+#endif /*STATIC_DICTIONARY_HPP_*/
@@ -0,0 +1,176 @@
+#include "aligned_array.hpp"
+#include "array.hpp"
+
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr AlignedArray<int, 5> make_squares()
+    {
+        AlignedArray<int, 5> result{};
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = static_cast<int>(i * i);
+        return result;
+    }
+
+    constexpr int sum_all(std::span<const int, 5> items)
+    {
+        int result = 0;
+        for (int item : items)
+            result += item;
+        return result;
+    }
+
+    bool is_aligned(const void* ptr, size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    }
+} // namespace
+
+TEST_CASE("AlignedArray")
+{
+    SECTION("is usable at compile time")
+    {
+        constexpr auto squares = make_squares();
+        static_assert(squares[4] == 16);
+        static_assert(sum_all(squares) == 30);
+
+        constexpr auto filled = [] {
+            AlignedArray<int, 5> arr{};
+            arr.fill(7);
+            return arr;
+        }();
+        static_assert(filled == AlignedArray<int, 5>{7, 7, 7, 7, 7});
+        static_assert(squares < filled);
+    }
+
+    SECTION("is aligned and padded to a cache line")
+    {
+        static_assert(alignof(AlignedBuffer<uint8_t>) == 64);
+        static_assert(sizeof(AlignedArray<uint8_t, 3>) == 64);
+        static_assert(sizeof(AlignedArray<uint8_t, 65>) == 128);
+
+        auto buffers = std::make_unique<AlignedBuffer<uint8_t>[]>(3);
+        for (size_t i = 0; i < 3; ++i)
+            REQUIRE(is_aligned(buffers[i].data(), 64));
+
+        AlignedArray<double, 4, 32> avx_lanes{};
+        REQUIRE(is_aligned(&avx_lanes, 32));
+    }
+
+    SECTION("converts to std::span")
+    {
+        AlignedArray<int, 5> arr = {1, 2, 3, 4, 5};
+
+        std::span<int, 5> items = arr;
+        items[0] = 42;
+        REQUIRE(arr[0] == 42);
+
+        const auto& const_arr = arr;
+        std::span<const int, 5> const_items = const_arr;
+        REQUIRE(const_items.data() == arr.data());
+        REQUIRE(sum_all(arr) == 42 + 2 + 3 + 4 + 5);
+    }
+}
+
+template <typename TCounter>
+void count_in_threads(std::vector<TCounter>& counters, uint64_t iterations)
+{
+    std::vector<std::thread> threads;
+    for (auto& counter : counters)
+    {
+        threads.emplace_back([&counter, iterations] {
+            std::atomic_ref<uint64_t> value{counter[0]};
+            for (uint64_t i = 0; i < iterations; ++i)
+                value.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    for (auto& thd : threads)
+        thd.join();
+}
+
+TEST_CASE("AlignedArray - per-thread buffers without false sharing")
+{
+    const size_t no_of_threads = 4;
+
+    std::vector<AlignedArray<uint64_t, 1>> counters(no_of_threads);
+    count_in_threads(counters, 10'000);
+
+    for (size_t i = 0; i < no_of_threads; ++i)
+    {
+        REQUIRE(counters[i][0] == 10'000);
+        REQUIRE(is_aligned(&counters[i], 64));
+    }
+
+    static_assert(sizeof(AlignedArray<uint64_t, 1>) == 64);
+    static_assert(sizeof(Array<uint64_t, 1>) == 8); // eight packed counters share a cache line
+}
+
+namespace
+{
+    uint32_t sum_bytes(const uint8_t* data, size_t size)
+    {
+        uint32_t result = 0;
+        for (size_t i = 0; i < size; ++i)
+            result += data[i];
+        return result;
+    }
+
+    uint32_t sum_aligned_bytes(const uint8_t* data, size_t size)
+    {
+        return sum_bytes(std::assume_aligned<64>(data), size);
+    }
+
+    struct alignas(64) MisalignedBuffer
+    {
+        uint8_t padding;
+        Buffer<uint8_t> buffer;
+    };
+} // namespace
+
+TEST_CASE("AlignedArray - benchmarks", "[.][benchmark]")
+{
+    AlignedBuffer<uint8_t> aligned;
+    std::iota(aligned.begin(), aligned.end(), uint8_t{0});
+
+    MisalignedBuffer misaligned{};
+    std::iota(misaligned.buffer.begin(), misaligned.buffer.end(), uint8_t{0});
+
+    BENCHMARK("sum of bytes - AlignedBuffer<uint8_t>")
+    {
+        return sum_aligned_bytes(aligned.data(), aligned.size());
+    };
+
+    BENCHMARK("sum of bytes - misaligned Buffer<uint8_t>")
+    {
+        return sum_bytes(misaligned.buffer.begin(), misaligned.buffer.size());
+    };
+
+    for (size_t no_of_threads : {2, 4, 8})
+    {
+        const auto threads_desc = " - " + std::to_string(no_of_threads) + " threads";
+
+        BENCHMARK("per-thread counters - packed Array" + threads_desc)
+        {
+            std::vector<Array<uint64_t, 1>> counters(no_of_threads);
+            count_in_threads(counters, 1'000'000);
+            return counters[0][0];
+        };
+
+        BENCHMARK("per-thread counters - AlignedArray" + threads_desc)
+        {
+            std::vector<AlignedArray<uint64_t, 1>> counters(no_of_threads);
+            count_in_threads(counters, 1'000'000);
+            return counters[0][0];
+        };
+    }
+}
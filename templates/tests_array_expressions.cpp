@@ -0,0 +1,125 @@
+#include "array.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <type_traits>
+
+namespace WithTemporaries
+{
+    template <typename T, size_t N>
+    Array<T, N> add(const Array<T, N>& a, const Array<T, N>& b)
+    {
+        Array<T, N> result;
+        for (size_t i = 0; i < N; ++i)
+            result[i] = a[i] + b[i];
+        return result;
+    }
+
+    template <typename T, size_t N>
+    Array<T, N> multiply(const Array<T, N>& a, const Array<T, N>& b)
+    {
+        Array<T, N> result;
+        for (size_t i = 0; i < N; ++i)
+            result[i] = a[i] * b[i];
+        return result;
+    }
+} // namespace WithTemporaries
+
+TEST_CASE("Array - expression templates")
+{
+    Array<int, 10> a{};
+    Array<int, 10> b{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Array<int, 10> c{10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    Array<int, 10> d{2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+
+    SECTION("element-wise operations are evaluated on assignment")
+    {
+        a = b + c * d;
+
+        for (size_t i = 0; i < a.size(); ++i)
+            REQUIRE(a[i] == b[i] + c[i] * d[i]);
+
+        a = (b - c) / d;
+        REQUIRE(a[0] == (1 - 10) / 2);
+        REQUIRE(a[9] == (10 - 1) / 2);
+    }
+
+    SECTION("no temporary arrays are created")
+    {
+        using Expr = decltype(b + c * d);
+
+        static_assert(!std::is_same_v<Expr, Array<int, 10>>);
+        static_assert(sizeof(Expr) <= 3 * sizeof(void*)); // references to b, c & d - no copies of items
+        static_assert(Expressions::size_v<Expr> == 10);
+    }
+
+    SECTION("scalar broadcasting")
+    {
+        a = 2 * b + 1;
+        REQUIRE(a[0] == 3);
+        REQUIRE(a[9] == 21);
+
+        a = b - 1;
+        REQUIRE(a[0] == 0);
+    }
+
+    SECTION("assignment to one of operands")
+    {
+        b = b + b;
+        REQUIRE(b[9] == 20);
+    }
+
+    SECTION("reductions")
+    {
+        REQUIRE(sum(b) == 55);
+        REQUIRE(sum(b * d) == 110);
+        REQUIRE(max(b - c) == 9);
+        REQUIRE(max(c) == 10);
+
+        const Array<double, 3> small{1.5, -2.0, 0.5};
+        REQUIRE(max(small) == 1.5);
+        REQUIRE(sum(small * 2) == 0.0);
+    }
+}
+
+TEST_CASE("Array - expression templates - benchmarks", "[.][benchmark]")
+{
+    auto run = [](auto& a, const auto& b, const auto& c, const auto& d, const char* desc) {
+        BENCHMARK(std::string("with temporaries - ") + desc)
+        {
+            a = WithTemporaries::add(b, WithTemporaries::multiply(c, d));
+            return a[0];
+        };
+
+        BENCHMARK(std::string("expression templates - ") + desc)
+        {
+            a = b + c * d;
+            return a[0];
+        };
+
+        BENCHMARK(std::string("sum - ") + desc)
+        {
+            return sum(b + c * d);
+        };
+    };
+
+    {
+        Buffer<float> a{}, b{}, c{}, d{};
+        std::iota(b.begin(), b.end(), 1.0f);
+        std::fill(c.begin(), c.end(), 2.0f);
+        std::fill(d.begin(), d.end(), 0.5f);
+
+        run(a, b, c, d, "Buffer<float> (N = 1024)");
+    }
+
+    {
+        LargeBuffer<float> a{}, b{}, c{}, d{};
+        std::iota(b.begin(), b.end(), 1.0f);
+        std::fill(c.begin(), c.end(), 2.0f);
+        std::fill(d.begin(), d.end(), 0.5f);
+
+        run(a, b, c, d, "LargeBuffer<float> (N = 2048)");
+    }
+}
@@ -0,0 +1,249 @@
+#include "flat_dictionary.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // counts allocations made through it - proves that heterogeneous lookups do not allocate
+    class CountingResource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource* upstream_;
+        size_t allocations_ = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations_;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            upstream_->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : upstream_{upstream}
+        { }
+
+        size_t allocations() const
+        {
+            return allocations_;
+        }
+    };
+} // namespace
+
+TEST_CASE("FlatDictionary")
+{
+    using namespace std::literals;
+
+    FlatDictionary<int> dict = {{"one", 1}, {"two", 2}, {"three", 3}};
+
+    SECTION("lookup")
+    {
+        REQUIRE(dict.size() == 3);
+        REQUIRE(dict.at("two") == 2);
+        REQUIRE(dict.contains("three"sv));
+        REQUIRE(dict.find("four") == dict.end());
+        REQUIRE_THROWS_AS(dict.at("four"), std::out_of_range);
+    }
+
+    SECTION("find with string_view or literal never allocates")
+    {
+        CountingResource resource;
+        pmr::FlatDictionary<int> counted_dict{{{"one", 1}, {"two", 2}}, &resource};
+
+        const std::string long_key(100, 'k');
+        counted_dict[long_key] = 100;
+        REQUIRE(counted_dict.begin()->first.get_allocator().resource() == &resource); // keys are counted too
+
+        const size_t allocations_before = resource.allocations();
+
+        const int long_value = counted_dict.find(std::string_view{long_key})->second;
+        const int short_value = counted_dict.find("one")->second;
+        const bool has_missing_key = counted_dict.contains("a key that is longer than any small string buffer");
+
+        const size_t allocations = resource.allocations() - allocations_before;
+
+        REQUIRE(allocations == 0);
+        REQUIRE(long_value == 100);
+        REQUIRE(short_value == 1);
+        REQUIRE(!has_missing_key);
+    }
+
+    SECTION("insert")
+    {
+        auto [pos, inserted] = dict.insert({"four", 4});
+        REQUIRE(inserted);
+        REQUIRE(pos->second == 4);
+
+        std::tie(pos, inserted) = dict.insert({"one", 111});
+        REQUIRE(!inserted);
+        REQUIRE(pos->second == 1);
+
+        dict.insert_or_assign("one", 111);
+        REQUIRE(dict["one"] == 111);
+
+        dict["five"] += 5;
+        REQUIRE(dict.at("five") == 5);
+    }
+
+    SECTION("existing key does not trigger a rehash")
+    {
+        CountingResource resource;
+        pmr::FlatDictionary<int> counted_dict{{{"1", 1}, {"2", 2}, {"3", 3}, {"4", 4}, {"5", 5}, {"6", 6}}, &resource};
+
+        const size_t allocations_before = resource.allocations();
+
+        counted_dict["1"] = 11; // the next new key would grow the slots
+        counted_dict.insert({"2", 22});
+        counted_dict.try_emplace("3", 33);
+
+        REQUIRE(resource.allocations() == allocations_before);
+        REQUIRE(counted_dict.at("1") == 11);
+        REQUIRE(counted_dict.at("2") == 2);
+    }
+
+    SECTION("insert of an rvalue moves the key")
+    {
+        std::pair<std::string, int> item{std::string(100, 'k'), 100};
+        const char* key_buffer = item.first.data();
+
+        auto [pos, inserted] = dict.insert(std::move(item));
+
+        REQUIRE(inserted);
+        REQUIRE(pos->first.data() == key_buffer);
+    }
+
+    SECTION("keys cannot be modified through iterators")
+    {
+        static_assert(!std::is_assignable_v<decltype((dict.begin()->first)), std::string>);
+        static_assert(!std::is_assignable_v<decltype(((*dict.begin()).first)), std::string>);
+        static_assert(std::is_same_v<std::iterator_traits<FlatDictionary<int>::iterator>::iterator_category, std::input_iterator_tag>);
+        static_assert(std::random_access_iterator<FlatDictionary<int>::iterator>);
+
+        dict.begin()->second = 10;
+        REQUIRE(dict.at("one") == 10);
+    }
+
+    SECTION("iteration in insertion order")
+    {
+        for (int i = 0; i < 100; ++i)
+            dict["key" + std::to_string(i)] = i;
+
+        std::vector<std::string> keys;
+        for (const auto& [key, value] : dict)
+            keys.push_back(key);
+
+        REQUIRE(keys.size() == 103);
+        REQUIRE(keys[0] == "one");
+        REQUIRE(keys[2] == "three");
+        REQUIRE(keys[3] == "key0");
+        REQUIRE(keys[102] == "key99");
+    }
+
+    SECTION("erase keeps order of remaining items")
+    {
+        REQUIRE(dict.erase("two") == 1);
+        REQUIRE(dict.erase("two") == 0);
+
+        REQUIRE(dict.size() == 2);
+        REQUIRE(dict.begin()->first == "one");
+        REQUIRE((dict.begin() + 1)->first == "three");
+        REQUIRE(dict.at("three") == 3);
+    }
+
+    SECTION("many keys - rehashing")
+    {
+        FlatDictionary<size_t> numbers;
+        for (size_t i = 0; i < 10'000; ++i)
+            numbers[std::to_string(i)] = i;
+
+        REQUIRE(numbers.size() == 10'000);
+        for (size_t i = 0; i < 10'000; ++i)
+            REQUIRE(numbers.at(std::to_string(i)) == i);
+        REQUIRE(!numbers.contains("10000"));
+    }
+}
+
+namespace
+{
+    std::vector<std::string> make_keys(size_t count, std::string_view prefix)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            keys.push_back(std::string(prefix) + std::to_string(i * 2654435761u % 1'000'000'007));
+        return keys;
+    }
+
+    template <typename TDict>
+    void benchmark_dictionary(const std::string& desc, const std::vector<std::string>& keys, const std::vector<std::string>& missing_keys)
+    {
+        BENCHMARK_ADVANCED("insert - " + desc)(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure([&] {
+                TDict dict;
+                for (const auto& key : keys)
+                    dict[key] = 1;
+                return dict.size();
+            });
+        };
+
+        TDict dict;
+        for (const auto& key : keys)
+            dict[key] = 1;
+
+        BENCHMARK("hit - " + desc)
+        {
+            size_t found = 0;
+            for (const auto& key : keys)
+                found += dict.find(key) != dict.end();
+            return found;
+        };
+
+        BENCHMARK("miss - " + desc)
+        {
+            size_t found = 0;
+            for (const auto& key : missing_keys)
+                found += dict.find(key) != dict.end();
+            return found;
+        };
+
+        BENCHMARK("iteration - " + desc)
+        {
+            int sum = 0;
+            for (const auto& [key, value] : dict)
+                sum += value;
+            return sum;
+        };
+    }
+} // namespace
+
+TEST_CASE("FlatDictionary - benchmarks", "[.][benchmark]")
+{
+    for (size_t count : {1'000, 10'000, 100'000, 1'000'000, 10'000'000})
+    {
+        const auto keys = make_keys(count, "key#");
+        const auto missing_keys = make_keys(count, "missing#");
+        const auto size_desc = std::to_string(count) + " keys";
+
+        benchmark_dictionary<std::map<std::string, int, std::less<>>>("std::map - " + size_desc, keys, missing_keys);
+        benchmark_dictionary<std::unordered_map<std::string, int>>("std::unordered_map - " + size_desc, keys, missing_keys);
+        benchmark_dictionary<FlatDictionary<int>>("FlatDictionary - " + size_desc, keys, missing_keys);
+    }
+}
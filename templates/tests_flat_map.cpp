@@ -0,0 +1,197 @@
+#include "flat_map.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("FlatMap")
+{
+    using namespace std::literals;
+
+    SECTION("items are ordered by the comparator")
+    {
+        FlatMap<std::string, int, std::greater<>> dict = {{"b", 2}, {"d", 4}, {"a", 1}, {"c", 3}};
+
+        REQUIRE(dict.keys() == std::vector<std::string>{"d", "c", "b", "a"});
+        REQUIRE(dict.values() == std::vector<int>{4, 3, 2, 1});
+
+        std::vector<std::string> scanned;
+        for (const auto& [key, value] : dict)
+            scanned.push_back(key + "=" + std::to_string(value));
+        REQUIRE(scanned == std::vector<std::string>{"d=4", "c=3", "b=2", "a=1"});
+    }
+
+    SECTION("bulk construction sorts and removes duplicates - first occurrence wins")
+    {
+        const std::vector<std::pair<int, std::string>> items = {{3, "three"}, {1, "one"}, {3, "drei"}, {2, "two"}, {1, "eins"}};
+
+        FlatMap<int, std::string> numbers(items.begin(), items.end());
+        std::map<int, std::string> reference(items.begin(), items.end());
+
+        REQUIRE(numbers.size() == 3);
+        REQUIRE(std::equal(numbers.begin(), numbers.end(), reference.begin(), reference.end(), [](const auto& a, const auto& b) {
+            return a.first == b.first && a.second == b.second;
+        }));
+    }
+
+    SECTION("sorted input is adopted without sorting")
+    {
+        FlatMap<int, char> letters{sorted_unique, {1, 2, 3}, {'a', 'b', 'c'}};
+
+        REQUIRE(letters.at(2) == 'b');
+        REQUIRE_THROWS_AS((FlatMap<int, char>{sorted_unique, {1, 2}, {'a'}}), std::invalid_argument);
+    }
+
+    SECTION("lookup")
+    {
+        FlatMap<std::string, int, std::greater<>> dict = {{"one", 1}, {"two", 2}, {"three", 3}};
+
+        REQUIRE(dict.find("two")->second == 2);
+        REQUIRE(dict.find("two"sv)->first == "two");
+        REQUIRE(dict.find("four") == dict.end());
+        REQUIRE(dict.contains("three"));
+        REQUIRE(dict.count("four") == 0);
+        REQUIRE(dict.at("one") == 1);
+        REQUIRE_THROWS_AS(dict.at("four"), std::out_of_range);
+
+        dict.find("one")->second = 10;
+        REQUIRE(dict.at("one") == 10);
+    }
+
+    SECTION("lower_bound & upper_bound - range scans")
+    {
+        FlatMap<int, int, std::greater<>> squares;
+        for (int i = 0; i < 10; ++i)
+            squares[i] = i * i;
+
+        // descending order - range [7, 3]
+        std::vector<int> keys;
+        for (auto it = squares.lower_bound(7); it != squares.upper_bound(3); ++it)
+            keys.push_back(it->first);
+        REQUIRE(keys == std::vector<int>{7, 6, 5, 4, 3});
+
+        auto [first, last] = squares.equal_range(5);
+        REQUIRE(last - first == 1);
+        REQUIRE(first->second == 25);
+
+        REQUIRE(squares.lower_bound(100) == squares.begin());
+        REQUIRE(squares.upper_bound(-1) == squares.end());
+    }
+
+    SECTION("insert & erase keep the order")
+    {
+        FlatMap<std::string, int> dict;
+
+        REQUIRE(dict.insert({"b", 2}).second);
+        REQUIRE(dict.try_emplace("a", 1).second);
+        REQUIRE(!dict.try_emplace("a", 100).second);
+        REQUIRE(dict.insert_or_assign("c", 3).second);
+        REQUIRE(!dict.insert_or_assign("c", 30).second);
+        dict["d"] = 4;
+
+        REQUIRE(dict.keys() == std::vector<std::string>{"a", "b", "c", "d"});
+        REQUIRE(dict.values() == std::vector<int>{1, 2, 30, 4});
+
+        REQUIRE(dict.erase("b") == 1);
+        REQUIRE(dict.erase("b") == 0);
+        auto next = dict.erase(dict.find("c"));
+        REQUIRE(next->first == "d");
+        REQUIRE(dict.keys() == std::vector<std::string>{"a", "d"});
+    }
+
+    SECTION("moves are O(1) and do not throw")
+    {
+        using Map = FlatMap<std::string, int, std::greater<>>;
+        static_assert(std::is_nothrow_move_constructible_v<Map>);
+        static_assert(std::is_nothrow_move_assignable_v<Map>);
+
+        Map source = {{"one", 1}, {"two", 2}};
+        const auto* keys_data = source.keys().data();
+
+        Map target = std::move(source);
+
+        REQUIRE(target.keys().data() == keys_data);
+        REQUIRE(target.size() == 2);
+    }
+
+    SECTION("iterators are random access")
+    {
+        using Map = FlatMap<int, int>;
+        // proxy references (pairs of references) are not allowed for Cpp17 forward iterators - like views::zip
+        // the legacy category is input, the C++20 concept is random access
+        static_assert(std::is_same_v<std::iterator_traits<Map::iterator>::iterator_category, std::input_iterator_tag>);
+        static_assert(std::is_same_v<std::iterator_traits<Map::const_iterator>::iterator_category, std::input_iterator_tag>);
+        static_assert(std::is_same_v<Map::iterator::iterator_concept, std::random_access_iterator_tag>);
+        static_assert(std::is_convertible_v<Map::iterator, Map::const_iterator>);
+
+        const Map numbers = {{1, 10}, {2, 20}, {3, 30}};
+        REQUIRE(numbers.begin()[2].second == 30);
+        REQUIRE(numbers.end() - numbers.begin() == 3);
+    }
+}
+
+namespace
+{
+    std::vector<std::pair<std::string, int>> make_items(size_t count)
+    {
+        std::vector<std::pair<std::string, int>> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            items.emplace_back("key#" + std::to_string(i * 2654435761u % 1'000'000'007), static_cast<int>(i));
+        return items;
+    }
+
+    template <typename TMap>
+    void benchmark_map(const std::string& desc, const std::vector<std::pair<std::string, int>>& items)
+    {
+        BENCHMARK("build - " + desc)
+        {
+            return TMap(items.begin(), items.end()).size();
+        };
+
+        const TMap map(items.begin(), items.end());
+
+        BENCHMARK("point lookup - " + desc)
+        {
+            int sum = 0;
+            for (const auto& item : items)
+                sum += map.find(item.first)->second;
+            return sum;
+        };
+
+        BENCHMARK("ordered iteration - " + desc)
+        {
+            int sum = 0;
+            for (const auto& [key, value] : map)
+                sum += value;
+            return sum;
+        };
+
+        BENCHMARK("range scan - " + desc)
+        {
+            int sum = 0;
+            for (auto it = map.lower_bound("key#5"), last = map.upper_bound("key#3"); it != last; ++it)
+                sum += it->second;
+            return sum;
+        };
+    }
+} // namespace
+
+TEST_CASE("FlatMap - benchmarks", "[.][benchmark]")
+{
+    for (size_t count : {1'000, 100'000, 1'000'000})
+    {
+        const auto items = make_items(count);
+        const auto size_desc = std::to_string(count) + " keys";
+
+        benchmark_map<std::map<std::string, int, std::greater<>>>("std::map - " + size_desc, items);
+        benchmark_map<FlatMap<std::string, int, std::greater<>>>("FlatMap - " + size_desc, items);
+    }
+}
@@ -0,0 +1,240 @@
+#include "spsc_queue.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscQueue - single thread")
+{
+    SpscQueue<int, 4> q;
+
+    SECTION("is empty after construction")
+    {
+        REQUIRE(q.empty());
+
+        int item;
+        REQUIRE(!q.try_pop(item));
+    }
+
+    SECTION("FIFO order")
+    {
+        REQUIRE(q.try_push(1));
+        REQUIRE(q.try_push(2));
+
+        int a, b;
+        REQUIRE(q.try_pop(a));
+        REQUIRE(q.try_pop(b));
+        REQUIRE(a == 1);
+        REQUIRE(b == 2);
+    }
+
+    SECTION("push fails when full")
+    {
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(q.try_push(i));
+
+        REQUIRE(!q.try_push(4));
+        REQUIRE(q.size() == 4);
+    }
+
+    SECTION("indexes wrap around")
+    {
+        int item;
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(q.try_push(i));
+            REQUIRE(q.try_push(i + 1));
+            REQUIRE(q.try_pop(item));
+            REQUIRE(item == i);
+            REQUIRE(q.try_pop(item));
+            REQUIRE(item == i + 1);
+        }
+    }
+
+    SECTION("batch push_n & pop_n")
+    {
+        std::vector<int> items = {1, 2, 3, 4, 5, 6};
+
+        REQUIRE(q.push_n(items.begin(), items.size()) == 4);
+
+        std::vector<int> popped;
+        REQUIRE(q.pop_n(std::back_inserter(popped), 3) == 3);
+        REQUIRE(popped == std::vector<int>{1, 2, 3});
+
+        REQUIRE(q.push_n(items.begin() + 4, 2) == 2);
+        REQUIRE(q.pop_n(std::back_inserter(popped), 10) == 3);
+        REQUIRE(popped == std::vector<int>{1, 2, 3, 4, 5, 6});
+    }
+}
+
+TEST_CASE("SpscQueue - move-only items")
+{
+    SpscQueue<std::unique_ptr<std::string>, 8> q;
+
+    auto text = std::make_unique<std::string>("text");
+    REQUIRE(q.try_push(std::move(text)));
+
+    std::vector<std::unique_ptr<std::string>> batch;
+    batch.push_back(std::make_unique<std::string>("one"));
+    batch.push_back(std::make_unique<std::string>("two"));
+    REQUIRE(q.push_n(std::make_move_iterator(batch.begin()), batch.size()) == 2);
+    REQUIRE(batch[0] == nullptr);
+
+    std::unique_ptr<std::string> item;
+    REQUIRE(q.try_pop(item));
+    REQUIRE(*item == "text");
+
+    std::vector<std::unique_ptr<std::string>> popped(2);
+    REQUIRE(q.pop_n(popped.begin(), 2) == 2);
+    REQUIRE(*popped[1] == "two");
+}
+
+TEST_CASE("SpscQueue - producer & consumer threads")
+{
+    constexpr int no_of_items = 1'000'000;
+    auto q = std::make_unique<SpscQueue<int, 1024>>();
+
+    std::thread producer{[&q] {
+        for (int i = 0; i < no_of_items; ++i)
+        {
+            while (!q->try_push(i))
+                std::this_thread::yield();
+        }
+    }};
+
+    bool in_order = true;
+    int expected = 0;
+    while (expected < no_of_items)
+    {
+        int item;
+        if (q->try_pop(item))
+            in_order &= (item == expected++);
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(q->empty());
+}
+
+namespace
+{
+    template <typename T>
+    class LockedQueue
+    {
+        std::deque<T> items_;
+        std::mutex mtx_;
+
+    public:
+        bool try_push(T item)
+        {
+            std::lock_guard lk{mtx_};
+            items_.push_back(std::move(item));
+            return true;
+        }
+
+        bool try_pop(T& item)
+        {
+            std::lock_guard lk{mtx_};
+            if (items_.empty())
+                return false;
+
+            item = std::move(items_.front());
+            items_.pop_front();
+            return true;
+        }
+    };
+
+    template <typename TQueue>
+    long long transfer(TQueue& q, int no_of_items)
+    {
+        std::thread producer{[&q, no_of_items] {
+            for (int i = 0; i < no_of_items; ++i)
+            {
+                while (!q.try_push(i))
+                    std::this_thread::yield();
+            }
+        }};
+
+        long long sum = 0;
+        for (int received = 0; received < no_of_items;)
+        {
+            int item;
+            if (q.try_pop(item))
+            {
+                sum += item;
+                ++received;
+            }
+            else
+                std::this_thread::yield();
+        }
+
+        producer.join();
+        return sum;
+    }
+
+    template <typename TQueue>
+    void ping_pong(TQueue& ping, TQueue& pong, int round_trips)
+    {
+        std::thread echo{[&ping, &pong, round_trips] {
+            int item;
+            for (int i = 0; i < round_trips; ++i)
+            {
+                while (!ping.try_pop(item))
+                    std::this_thread::yield();
+                while (!pong.try_push(item))
+                    std::this_thread::yield();
+            }
+        }};
+
+        int item;
+        for (int i = 0; i < round_trips; ++i)
+        {
+            while (!ping.try_push(i))
+                std::this_thread::yield();
+            while (!pong.try_pop(item))
+                std::this_thread::yield();
+        }
+
+        echo.join();
+    }
+} // namespace
+
+TEST_CASE("SpscQueue - benchmarks", "[.][benchmark]")
+{
+    constexpr int no_of_items = 1'000'000;
+    constexpr int round_trips = 10'000;
+
+    BENCHMARK("throughput - SpscQueue<int, 1024>")
+    {
+        auto q = std::make_unique<SpscQueue<int, 1024>>();
+        return transfer(*q, no_of_items);
+    };
+
+    BENCHMARK("throughput - mutex + std::deque<int>")
+    {
+        LockedQueue<int> q;
+        return transfer(q, no_of_items);
+    };
+
+    BENCHMARK("latency (round trips) - SpscQueue<int, 1024>")
+    {
+        auto ping = std::make_unique<SpscQueue<int, 1024>>();
+        auto pong = std::make_unique<SpscQueue<int, 1024>>();
+        ping_pong(*ping, *pong, round_trips);
+    };
+
+    BENCHMARK("latency (round trips) - mutex + std::deque<int>")
+    {
+        LockedQueue<int> ping, pong;
+        ping_pong(ping, pong, round_trips);
+    };
+}
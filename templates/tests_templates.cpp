@@ -1,12 +1,26 @@
+#include "array.hpp"
+#include "flat_map.hpp"
+#include "format_utils.hpp"
+#include "simd_find.hpp"
+#include "static_dictionary.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
 #include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <cstring>
@@ -27,7 +41,7 @@ namespace WithoutTemplates
 } // namespace WithoutTemplates
 
 template <typename T>
-T maximum(T a, T b)
+constexpr T maximum(T a, T b)
 {
     return a < b ? b : a;
 }
@@ -43,6 +57,114 @@ const char* maximum(const char* a, const char* b)
     return std::strcmp(a, b) < 0 ? b : a;
 }
 
+// variadic version - unrolled at compile time into a chain of two-argument calls
+template <typename T, typename... TRest>
+    requires(sizeof...(TRest) > 0 && (std::is_same_v<T, TRest> && ...))
+constexpr T maximum(T a, T b, TRest... rest)
+{
+    T result = maximum(a, b);
+    ((result = maximum(result, rest)), ...);
+    return result;
+}
+
+namespace Detail
+{
+    // branchless reduction in independent lanes - compiled to packed max instructions (pmaxsd, maxps, ...)
+    // the result is the same as from a sequential scan for input without NaNs
+    template <typename T>
+    T maximum_in_lanes(const T* data, size_t size)
+    {
+        constexpr size_t lanes = 64 / sizeof(T) < 8 ? 8 : 64 / sizeof(T);
+
+        T result = data[0];
+        size_t i = 0;
+
+        if (size >= lanes)
+        {
+            T partial[lanes];
+            std::copy_n(data, lanes, partial);
+
+            for (i = lanes; i + lanes <= size; i += lanes)
+                for (size_t lane = 0; lane < lanes; ++lane)
+                    partial[lane] = partial[lane] < data[i + lane] ? data[i + lane] : partial[lane];
+
+            result = partial[0];
+            for (size_t lane = 1; lane < lanes; ++lane)
+                result = result < partial[lane] ? partial[lane] : result;
+        }
+
+        for (; i < size; ++i)
+            result = result < data[i] ? data[i] : result;
+
+        return result;
+    }
+
+    // first 8 characters packed big-endian (zero filled after the terminator) -
+    // integer order of prefixes is the strcmp order of strings
+    inline uint64_t string_prefix(const char* text)
+    {
+        uint64_t prefix = 0;
+        size_t length = 0;
+        for (; length < 8 && text[length] != '\0'; ++length)
+            prefix = (prefix << 8) | static_cast<unsigned char>(text[length]);
+
+        return length == 0 ? 0 : prefix << (8 * (8 - length));
+    }
+
+    // the prefix of the current maximum is cached - most candidates are rejected with one integer compare
+    template <typename Iterator>
+    std::iter_value_t<Iterator> maximum_of_c_strings(Iterator first, Iterator last)
+    {
+        auto result = *first;
+        uint64_t result_prefix = string_prefix(result);
+
+        for (++first; first != last; ++first)
+        {
+            const uint64_t prefix = string_prefix(*first);
+            if (prefix < result_prefix)
+                continue;
+
+            // for equal prefixes the tails are compared only if strings are longer than the prefix
+            const bool is_longer_than_prefix = (prefix & 0xFF) != 0;
+            if (prefix > result_prefix || (is_longer_than_prefix && std::strcmp(result + 8, *first + 8) < 0))
+            {
+                result = *first;
+                result_prefix = prefix;
+            }
+        }
+
+        return result;
+    }
+} // namespace Detail
+
+// maximum of a non-empty range
+template <std::ranges::forward_range TRange>
+std::ranges::range_value_t<TRange> maximum(const TRange& range)
+{
+    using T = std::ranges::range_value_t<TRange>;
+
+    auto first = std::ranges::begin(range);
+    auto last = std::ranges::end(range);
+    if (first == last)
+        throw std::invalid_argument("maximum - empty range");
+
+    if constexpr (std::ranges::contiguous_range<TRange> && std::ranges::sized_range<TRange> && std::is_arithmetic_v<T>)
+    {
+        return Detail::maximum_in_lanes(std::ranges::data(range), std::ranges::size(range));
+    }
+    else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+    {
+        return Detail::maximum_of_c_strings(first, last);
+    }
+    else
+    {
+        T result = *first;
+        for (++first; first != last; ++first)
+            result = maximum(result, *first);
+        return result;
+    }
+}
+
 struct Value
 {
     int value;
@@ -79,6 +201,139 @@ TEST_CASE("function templates")
     int (*ptr_fun)(int, int) = &maximum<int>; // taking address of template function
 }
 
+TEST_CASE("maximum - variadic & ranges")
+{
+    using namespace std::literals;
+
+    SECTION("variadic")
+    {
+        static_assert(maximum(1, 7, 3, 5) == 7);
+        static_assert(maximum(1.5, -2.0, 0.5) == 1.5);
+
+        REQUIRE(maximum("Ala"s, "Ola"s, "Ela"s) == "Ola"s);
+        REQUIRE(std::strcmp(maximum("Ala", "Zenon", "Ola"), "Zenon") == 0);
+    }
+
+    SECTION("contiguous ranges of arithmetic values")
+    {
+        std::vector<int> numbers(1000);
+        std::iota(numbers.begin(), numbers.end(), -500);
+        std::shuffle(numbers.begin(), numbers.end(), std::mt19937{42});
+
+        for (size_t size = 1; size <= numbers.size(); size += 7)
+        {
+            std::span<const int> prefix{numbers.data(), size};
+            REQUIRE(maximum(prefix) == *std::max_element(prefix.begin(), prefix.end()));
+        }
+
+        const double values[] = {-1.0, 3.5, 2.25, -7.0, 3.25, 0.0, 1.0, 2.0, 3.0, -4.0, 5.5, 0.5};
+        REQUIRE(maximum(values) == 5.5);
+
+        const std::array<uint8_t, 3> bytes = {7, 255, 0};
+        REQUIRE(maximum(bytes) == 255);
+    }
+
+    SECTION("other ranges")
+    {
+        const std::list<int> lst = {1, 42, 7};
+        REQUIRE(maximum(lst) == 42);
+
+        const std::vector<std::string> words = {"Ala", "Ola", "Ela"};
+        REQUIRE(maximum(words) == "Ola");
+
+        REQUIRE_THROWS_AS(maximum(std::vector<int>{}), std::invalid_argument);
+    }
+
+    SECTION("C-strings - prefixes are compared first")
+    {
+        const std::vector<const char*> words = {"", "abc", "abcdefgh", "abcdefgh-2", "abcdefgh-10", "abcdefg", "ab"};
+        REQUIRE(std::strcmp(maximum(words), "abcdefgh-2") == 0);
+
+        const std::vector<const char*> same = {"text", "text", "text"};
+        REQUIRE(maximum(same) == same[0]); // first of equal items - as std::max_element
+
+        const char* high_chars[] = {"abc", "ab\xff", "ab\x7f"};
+        REQUIRE(std::strcmp(maximum(high_chars), "ab\xff") == 0);
+
+        std::vector<std::string> texts;
+        for (int i = 0; i < 500; ++i)
+            texts.push_back("common-prefix-" + std::to_string(i * 7919 % 1000));
+        std::vector<const char*> c_strings;
+        for (const auto& text : texts)
+            c_strings.push_back(text.c_str());
+
+        auto expected = *std::max_element(c_strings.begin(), c_strings.end(), [](const char* a, const char* b) { return std::strcmp(a, b) < 0; });
+        REQUIRE(maximum(c_strings) == expected);
+    }
+}
+
+TEST_CASE("maximum - benchmarks", "[.][benchmark]")
+{
+    std::mt19937 rnd{665};
+
+    std::vector<int> ints(1'000'000);
+    std::uniform_int_distribution<int> int_distr{-1'000'000, 1'000'000};
+    std::generate(ints.begin(), ints.end(), [&] { return int_distr(rnd); });
+
+    std::vector<double> doubles(1'000'000);
+    std::uniform_real_distribution<double> real_distr{-1000.0, 1000.0};
+    std::generate(doubles.begin(), doubles.end(), [&] { return real_distr(rnd); });
+
+    std::vector<std::string> texts;
+    for (int i = 0; i < 100'000; ++i)
+        texts.push_back("key#" + std::to_string(int_distr(rnd)));
+    std::vector<const char*> c_strings;
+    for (const auto& text : texts)
+        c_strings.push_back(text.c_str());
+
+    auto scalar_loop = [](const auto& range) {
+        auto result = range[0];
+        for (const auto& item : range)
+            result = maximum(result, item);
+        return result;
+    };
+
+    BENCHMARK("std::max_element - 1M ints")
+    {
+        return *std::max_element(ints.begin(), ints.end());
+    };
+
+    BENCHMARK("loop of maximum(a, b) - 1M ints")
+    {
+        return scalar_loop(ints);
+    };
+
+    BENCHMARK("maximum(range) - 1M ints")
+    {
+        return maximum(ints);
+    };
+
+    BENCHMARK("std::max_element - 1M doubles")
+    {
+        return *std::max_element(doubles.begin(), doubles.end());
+    };
+
+    BENCHMARK("maximum(range) - 1M doubles")
+    {
+        return maximum(doubles);
+    };
+
+    BENCHMARK("std::max_element(strcmp) - 100K C-strings")
+    {
+        return *std::max_element(c_strings.begin(), c_strings.end(), [](const char* a, const char* b) { return std::strcmp(a, b) < 0; });
+    };
+
+    BENCHMARK("loop of maximum(a, b) - 100K C-strings")
+    {
+        return scalar_loop(c_strings);
+    };
+
+    BENCHMARK("maximum(range) - 100K C-strings")
+    {
+        return maximum(c_strings);
+    };
+}
+
 // int* my_find(int* begin, int* end, int value)
 // {
 //     for(int* pos = begin; pos != end; ++pos)
@@ -101,12 +356,58 @@ TEST_CASE("function templates")
 //     return end;
 // }
 
+namespace Detail
+{
+    // a == b - for arithmetic types the usual arithmetic conversions are explicit (no -Wsign-compare for mixed signedness)
+    template <typename T1, typename T2>
+    constexpr bool is_equal(const T1& a, const T2& b)
+    {
+        if constexpr (std::is_arithmetic_v<T1> && std::is_arithmetic_v<T2>)
+        {
+            using TCommon = std::common_type_t<T1, T2>;
+            return static_cast<TCommon>(a) == static_cast<TCommon>(b);
+        }
+        else
+            return a == b;
+    }
+
+    // contiguous range of arithmetic values that can be scanned with Simd::find
+    template <typename Iterator, typename TValue>
+    constexpr bool is_vectorizable_find()
+    {
+        if constexpr (std::contiguous_iterator<Iterator>)
+        {
+            using T = std::iter_value_t<Iterator>;
+
+            if constexpr (std::is_floating_point_v<T>)
+                return Simd::is_searchable_v<T> && std::is_same_v<T, TValue>;
+            else
+                return Simd::is_searchable_v<T> && std::is_integral_v<TValue> && !std::is_same_v<TValue, bool>;
+        }
+        else
+            return false;
+    }
+} // namespace Detail
+
 template <typename Iterator, typename TValue>
 Iterator my_find(Iterator begin, Iterator end, const TValue& value)
 {
+    if constexpr (Detail::is_vectorizable_find<Iterator, TValue>())
+    {
+        using T = std::iter_value_t<Iterator>;
+
+        // only an item equal to T(value) can compare equal to value - if even that one does not, nothing will
+        const T needle = static_cast<T>(value);
+        if (!Detail::is_equal(needle, value))
+            return end;
+
+        const T* first = std::to_address(begin);
+        return begin + (Simd::find(first, first + (end - begin), needle) - first);
+    }
+
     for (Iterator pos = begin; pos != end; ++pos)
     {
-        if (*pos == value)
+        if (Detail::is_equal(*pos, value))
             return pos;
     }
 
@@ -116,10 +417,42 @@ Iterator my_find(Iterator begin, Iterator end, const TValue& value)
 template <typename Iterator, typename TTarget>
 void my_pusher(Iterator begin, Iterator end, TTarget& target)
 {
-    for (Iterator pos = begin; pos != end; ++pos)
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+    if constexpr (requires { target.append_range(std::ranges::subrange(begin, end)); })
+    {
+        target.append_range(std::ranges::subrange(begin, end));
+    }
+    else if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category> && requires { target.insert(target.end(), begin, end); })
     {
-        target.push_back(*pos);
+        target.insert(target.end(), begin, end); // range insert measures forward ranges - at most one reallocation
     }
+    else
+    {
+        if constexpr (std::sized_sentinel_for<Iterator, Iterator> && requires { target.reserve(target.capacity()); })
+        {
+            const size_t required_size = target.size() + static_cast<size_t>(end - begin);
+            if (required_size > target.capacity())
+                target.reserve(std::max(required_size, 2 * target.capacity())); // keeps growth geometric for repeated calls
+        }
+
+        for (Iterator pos = begin; pos != end; ++pos)
+        {
+            target.push_back(*pos);
+        }
+    }
+}
+
+// items of an rvalue range that owns them are moved to the target - views (std::span, views::filter...)
+// and borrowed ranges refer to someone else's items, so they are copied
+template <std::ranges::range TRange, typename TTarget>
+void my_pusher(TRange&& range, TTarget& target)
+{
+    if constexpr (std::is_lvalue_reference_v<TRange> || std::ranges::borrowed_range<TRange>
+        || std::ranges::view<std::remove_cvref_t<TRange>>)
+        my_pusher(std::ranges::begin(range), std::ranges::end(range), target);
+    else
+        my_pusher(std::make_move_iterator(std::ranges::begin(range)), std::make_move_iterator(std::ranges::end(range)), target);
 }
 
 template <typename InputIterator, typename OutputIterator>
@@ -180,6 +513,188 @@ TEST_CASE("my_find - template function")
 //     return temp;
 // }
 
+namespace ver_1_0
+{
+    template <typename Iterator, typename TTarget>
+    void my_pusher(Iterator begin, Iterator end, TTarget& target)
+    {
+        for (Iterator pos = begin; pos != end; ++pos)
+        {
+            target.push_back(*pos);
+        }
+    }
+} // namespace ver_1_0
+
+template <typename T>
+class CountingAllocator
+{
+    size_t* allocations_;
+
+public:
+    using value_type = T;
+
+    explicit CountingAllocator(size_t* allocations) noexcept
+        : allocations_{allocations}
+    { }
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept
+        : allocations_{other.counter()}
+    { }
+
+    T* allocate(size_t n)
+    {
+        ++*allocations_;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    size_t* counter() const noexcept
+    {
+        return allocations_;
+    }
+
+    bool operator==(const CountingAllocator& other) const noexcept
+    {
+        return allocations_ == other.allocations_;
+    }
+};
+
+TEST_CASE("my_pusher - size aware bulk insertion")
+{
+    size_t allocations = 0;
+    std::vector<int, CountingAllocator<int>> target{CountingAllocator<int>{&allocations}};
+
+    SECTION("forward range - single allocation")
+    {
+        std::list<int> numbers(1000);
+        std::iota(numbers.begin(), numbers.end(), 0);
+
+        my_pusher(numbers.begin(), numbers.end(), target);
+
+        REQUIRE(allocations == 1);
+        REQUIRE(std::equal(target.begin(), target.end(), numbers.begin(), numbers.end()));
+
+        SECTION("loop version reallocates many times")
+        {
+            target.clear();
+            target.shrink_to_fit();
+            allocations = 0;
+
+            ver_1_0::my_pusher(numbers.begin(), numbers.end(), target);
+
+            REQUIRE(allocations > 5);
+        }
+    }
+
+    SECTION("sized input range - reserve once")
+    {
+        auto numbers = std::views::iota(0, 1000); // iterators are sized but only input iterators for the STL
+
+        my_pusher(numbers.begin(), numbers.end(), target);
+
+        REQUIRE(allocations == 1);
+        REQUIRE(target.size() == 1000);
+        REQUIRE(target.back() == 999);
+    }
+
+    SECTION("unsized input range")
+    {
+        std::istringstream input{"1 2 3 4 5"};
+
+        my_pusher(std::istream_iterator<int>{input}, std::istream_iterator<int>{}, target);
+
+        REQUIRE(target.size() == 5);
+        REQUIRE(target.back() == 5);
+    }
+
+    SECTION("move iterators move items")
+    {
+        std::vector<std::unique_ptr<int>> source;
+        source.push_back(std::make_unique<int>(1));
+        source.push_back(std::make_unique<int>(2));
+
+        std::vector<std::unique_ptr<int>> items;
+        my_pusher(std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()), items);
+
+        REQUIRE(*items[1] == 2);
+        REQUIRE(source[0] == nullptr);
+    }
+
+    SECTION("rvalue range is moved")
+    {
+        std::vector<std::string> words = {"one", "two", std::string(100, 'x')};
+        const char* long_word = words[2].data();
+
+        std::vector<std::string> items;
+        my_pusher(std::move(words), items);
+
+        REQUIRE(items.size() == 3);
+        REQUIRE(items[2].data() == long_word); // buffer stolen, not copied
+    }
+
+    SECTION("rvalue view is copied - the source is left intact")
+    {
+        std::vector<std::string> words = {"one", "two", std::string(100, 'x')};
+
+        std::vector<std::string> items;
+        my_pusher(std::span{words}, items);
+        my_pusher(words | std::views::filter([](const std::string& word) { return word.size() > 3; }), items);
+
+        REQUIRE(items == std::vector<std::string>{"one", "two", std::string(100, 'x'), std::string(100, 'x')});
+        REQUIRE(words == std::vector<std::string>{"one", "two", std::string(100, 'x')});
+    }
+
+    SECTION("lvalue range is copied")
+    {
+        const std::vector<int> numbers = {1, 2, 3};
+
+        my_pusher(numbers, target);
+
+        REQUIRE(allocations == 1);
+        REQUIRE(numbers.size() == 3);
+    }
+}
+
+TEST_CASE("my_pusher - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> numbers(10'000'000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    const std::list<int> list_numbers(numbers.begin(), numbers.begin() + 1'000'000);
+
+    BENCHMARK("loop push_back - vector<int> 10M")
+    {
+        std::vector<int> target;
+        ver_1_0::my_pusher(numbers.begin(), numbers.end(), target);
+        return target.size();
+    };
+
+    BENCHMARK("my_pusher - vector<int> 10M")
+    {
+        std::vector<int> target;
+        my_pusher(numbers.begin(), numbers.end(), target);
+        return target.size();
+    };
+
+    BENCHMARK("loop push_back - list<int> 1M")
+    {
+        std::vector<int> target;
+        ver_1_0::my_pusher(list_numbers.begin(), list_numbers.end(), target);
+        return target.size();
+    };
+
+    BENCHMARK("my_pusher - list<int> 1M")
+    {
+        std::vector<int> target;
+        my_pusher(list_numbers.begin(), list_numbers.end(), target);
+        return target.size();
+    };
+}
+
 namespace ver_1_0
 {
     template <typename T, typename U>
@@ -296,6 +811,15 @@ std::ostream& operator<<(std::ostream& out, const std::vector<T>& vec)
     return out;
 }
 
+// fallback for types that can only be written to streams
+template <typename T1, typename T2>
+std::string stream_pair_to_string(const T1& first, const T2& second)
+{
+    std::stringstream ss;
+    ss << "[ " << first << ", " << second << "]";
+    return ss.str();
+}
+
 template <typename T1, typename T2>
 class ValuePair
 {
@@ -329,14 +853,40 @@ public:
     }
 
     std::string to_string() const;
+
+    // caller-provided buffer - the same contract as std::to_chars
+    std::to_chars_result to_chars(char* first, char* last) const;
+
+    template <typename OutputIt>
+    OutputIt format_to(OutputIt out) const;
 };
 
 template <typename T1, typename T2>
 std::string ValuePair<T1, T2>::to_string() const
 {
-    std::stringstream ss;
-    ss << "[ " << first_ << ", " << second_ << "]";
-    return ss.str();
+    if constexpr (Formatting::Formattable<T1> && Formatting::Formattable<T2>)
+        return Formatting::pair_to_string(first_, second_);
+    else
+        return stream_pair_to_string(first_, second_);
+}
+
+template <typename T1, typename T2>
+std::to_chars_result ValuePair<T1, T2>::to_chars(char* first, char* last) const
+{
+    if constexpr (Formatting::Formattable<T1> && Formatting::Formattable<T2>)
+        return Formatting::pair_to_chars(first, last, first_, second_);
+    else
+        return Formatting::to_chars(first, last, to_string());
+}
+
+template <typename T1, typename T2>
+template <typename OutputIt>
+OutputIt ValuePair<T1, T2>::format_to(OutputIt out) const
+{
+    if constexpr (Formatting::Formattable<T1> && Formatting::Formattable<T2>)
+        return Formatting::format_pair_to(out, first_, second_);
+    else
+        return Formatting::format_to(out, to_string());
 }
 
 // partial specialization
@@ -377,12 +927,50 @@ public:
 
     std::string to_string() const
     {
-        std::stringstream ss;
-        ss << "[ " << first() << ", " << second() << "]";
-        return ss.str();
+        if constexpr (Formatting::Formattable<T>)
+            return Formatting::pair_to_string(first(), second());
+        else
+            return stream_pair_to_string(first(), second());
+    }
+
+    std::to_chars_result to_chars(char* first, char* last) const
+    {
+        if constexpr (Formatting::Formattable<T>)
+            return Formatting::pair_to_chars(first, last, items_[0], items_[1]);
+        else
+            return Formatting::to_chars(first, last, to_string());
+    }
+
+    template <typename OutputIt>
+    OutputIt format_to(OutputIt out) const
+    {
+        if constexpr (Formatting::Formattable<T>)
+            return Formatting::format_pair_to(out, first(), second());
+        else
+            return Formatting::format_to(out, to_string());
     }
 };
 
+// pairs of small trivially copyable types stay trivially copyable and fit in two registers (SysV x86-64 ABI),
+// so they may be passed by value without touching the memory
+template <typename T1, typename T2>
+constexpr bool is_passed_in_registers_v = std::is_trivially_copyable_v<ValuePair<T1, T2>> && sizeof(ValuePair<T1, T2>) <= 2 * sizeof(void*);
+
+static_assert(is_passed_in_registers_v<int, int>);
+static_assert(is_passed_in_registers_v<int, double>);
+static_assert(is_passed_in_registers_v<double, double>);
+static_assert(sizeof(ValuePair<int, int>) == 2 * sizeof(int));
+static_assert(!is_passed_in_registers_v<int, std::string>);
+
+namespace ver_1_0
+{
+    template <typename T1, typename T2>
+    std::string to_string(const ValuePair<T1, T2>& vp)
+    {
+        return stream_pair_to_string(vp.first(), vp.second());
+    }
+} // namespace ver_1_0
+
 void print(const ValuePair<int, std::string>& vp)
 {
     std::cout << "ValuePair: " << vp.to_string() << "\n";
@@ -406,51 +994,101 @@ TEST_CASE("class templates")
     std::cout << "vp3: " << vp3.to_string() << " - max: " << vp3.maximum() << "\n";
 }
 
-template <typename T, size_t N>
-struct Array
+TEST_CASE("ValuePair - formatting")
 {
-    T items[N];
+    using namespace std::literals;
 
-    using iterator = T*;
-    using const_iterator = const T*;
-    using reference = T&;
-    using const_reference = const T&;
+    const ValuePair<int, int> vp_ints{42, -665};
+    const ValuePair<double, float> vp_floats{3.14159265, 1e-10f};
+    const ValuePair<int, std::string> vp_text{1, "text"s};
+    const ValuePair<char, bool> vp_others{'x', true};
+    const ValuePair<std::string, std::vector<int>> vp_vector{"dataset", std::vector<int>{1, 2}};
 
-    size_t size() const
+    SECTION("to_string gives the same text as the stream based version")
     {
-        return N;
+        REQUIRE(vp_ints.to_string() == "[ 42, -665]");
+        REQUIRE(vp_ints.to_string() == ver_1_0::to_string(vp_ints));
+        REQUIRE(vp_floats.to_string() == ver_1_0::to_string(vp_floats));
+        REQUIRE(vp_text.to_string() == ver_1_0::to_string(vp_text));
+        REQUIRE(vp_others.to_string() == ver_1_0::to_string(vp_others));
+        REQUIRE(vp_vector.to_string() == ver_1_0::to_string(vp_vector));
+
+        const ValuePair<long long, double> vp_limits{std::numeric_limits<long long>::min(), -std::numeric_limits<double>::max()};
+        REQUIRE(vp_limits.to_string() == ver_1_0::to_string(vp_limits));
     }
 
-    iterator begin()
+    SECTION("to_chars into caller-provided buffer")
     {
-        return items;
-    }
+        char buffer[32];
+        auto [end, ec] = vp_text.to_chars(buffer, buffer + sizeof(buffer));
+        REQUIRE(ec == std::errc{});
+        REQUIRE(std::string_view(buffer, end) == "[ 1, text]");
 
-    iterator end()
-    {
-        return items + N;
+        char too_small[8];
+        REQUIRE(vp_ints.to_chars(too_small, too_small + sizeof(too_small)).ec == std::errc::value_too_large);
     }
 
-    const_iterator begin() const
+    SECTION("format_to output iterator")
     {
-        return items;
+        std::string log = "log: ";
+        vp_ints.format_to(std::back_inserter(log));
+        vp_floats.format_to(std::back_inserter(log));
+        REQUIRE(log == "log: [ 42, -665][ 3.14159, 1e-10]");
     }
+}
 
-    const_iterator end() const
+TEST_CASE("ValuePair - formatting - benchmarks", "[.][benchmark]")
+{
+    std::vector<ValuePair<int, int>> int_pairs;
+    std::vector<ValuePair<double, double>> double_pairs;
+    std::vector<ValuePair<int, std::string>> text_pairs;
+    for (int i = 0; i < 1'000; ++i)
     {
-        return items + N;
+        int_pairs.emplace_back(i * 7919, -i);
+        double_pairs.emplace_back(i * 0.125, i / 3.0);
+        text_pairs.emplace_back(i, "item");
     }
 
-    reference operator[](size_t index)
-    {
-        return items[index];
-    }
+    auto run = [](const auto& pairs, const std::string& desc) {
+        BENCHMARK("stringstream - " + desc)
+        {
+            size_t length = 0;
+            for (const auto& vp : pairs)
+                length += ver_1_0::to_string(vp).size();
+            return length;
+        };
 
-    const_reference operator[](size_t index) const
-    {
-        return items[index];
-    }
-};
+        BENCHMARK("to_string - " + desc)
+        {
+            size_t length = 0;
+            for (const auto& vp : pairs)
+                length += vp.to_string().size();
+            return length;
+        };
+
+        BENCHMARK("to_chars - " + desc)
+        {
+            char buffer[128];
+            size_t length = 0;
+            for (const auto& vp : pairs)
+                length += vp.to_chars(buffer, buffer + sizeof(buffer)).ptr - buffer;
+            return length;
+        };
+
+        std::string log;
+        BENCHMARK("format_to - " + desc)
+        {
+            log.clear();
+            for (const auto& vp : pairs)
+                vp.format_to(std::back_inserter(log));
+            return log.size();
+        };
+    };
+
+    run(int_pairs, "1000 x ValuePair<int, int>");
+    run(double_pairs, "1000 x ValuePair<double, double>");
+    run(text_pairs, "1000 x ValuePair<int, std::string>");
+}
 
 template <typename TContainer>
 void print(const TContainer& container, const std::string& desc = "")
@@ -486,29 +1124,255 @@ TEST_CASE("template parameters")
 template <typename T>
 using Dictionary = std::map<std::string, T>;
 
+// built once, then mostly scanned in order - sorted arrays instead of tree nodes
 template <typename T>
-using DictionaryDesc = std::map<std::string, T, std::greater<T>>;
-
-template <typename T>
-using Buffer = Array<T, 1024>;
-
-template <typename T>
-using LargeBuffer = Array<T, 2048>;
+using DictionaryDesc = FlatMap<std::string, T, std::greater<>>;
 
 template <typename TDict = Dictionary<std::string>>
 class Translator
 {
     TDict dict;
+
+public:
+    Translator() = default;
+
+    constexpr explicit Translator(TDict dict)
+        : dict{std::move(dict)}
+    { }
+
+    // words without translation are returned unchanged
+    constexpr std::string_view translate(std::string_view word) const
+    {
+        if constexpr (requires { dict.find(word); })
+        {
+            auto pos = dict.find(word);
+            return pos == dict.end() ? word : std::string_view{pos->second};
+        }
+        else
+        {
+            auto pos = dict.find(typename TDict::key_type{word});
+            return pos == dict.end() ? word : std::string_view{pos->second};
+        }
+    }
 };
 
 TEST_CASE("template aliases")
 {
     Dictionary<int> dict = { {"one", 1}, {"two", 2} };
 
+    DictionaryDesc<int> dict_desc = { {"one", 1}, {"two", 2}, {"three", 3} };
+    REQUIRE(dict_desc.begin()->first == "two");
+    REQUIRE(dict_desc.at("one") == 1);
+
+    Translator<DictionaryDesc<std::string>> translator{DictionaryDesc<std::string>{{"dog", "pies"}}};
+    REQUIRE(translator.translate("dog") == "pies");
+
     Buffer<uint8_t> buffer = {};
     LargeBuffer<uint8_t> large_buffer = {};
 }
 
+constexpr auto en_pl_dictionary = make_static_dictionary({
+    {"one", "jeden"}, {"two", "dwa"}, {"three", "trzy"}, {"four", "cztery"}, {"five", "pięć"},
+    {"six", "sześć"}, {"seven", "siedem"}, {"eight", "osiem"}, {"nine", "dziewięć"}, {"ten", "dziesięć"},
+    {"dog", "pies"}, {"cat", "kot"}, {"house", "dom"}, {"tree", "drzewo"}, {"book", "książka"},
+    {"water", "woda"}, {"bread", "chleb"}, {"window", "okno"}, {"table", "stół"}, {"city", "miasto"}
+});
+
+TEST_CASE("Translator with compile-time perfect hash dictionary")
+{
+    // the whole table is built during compilation - no startup cost
+    static_assert(en_pl_dictionary.size() == 20);
+    static_assert(en_pl_dictionary.at("dog") == "pies");
+    static_assert(en_pl_dictionary.find("dog") != en_pl_dictionary.end());
+    static_assert(!en_pl_dictionary.contains("elephant"));
+    static_assert(!en_pl_dictionary.contains(""));
+
+    constexpr Translator<StaticDictionary<20>> translator{en_pl_dictionary};
+    static_assert(translator.translate("seven") == "siedem");
+    static_assert(translator.translate("elephant") == "elephant");
+
+    SECTION("every key is found at runtime")
+    {
+        const std::pair<std::string_view, std::string_view> expected[] = {{"one", "jeden"}, {"ten", "dziesięć"}, {"city", "miasto"}, {"table", "stół"}};
+
+        for (const auto& [en, pl] : expected)
+            REQUIRE(translator.translate(std::string{en}) == pl);
+    }
+
+    SECTION("same interface as Translator on Dictionary")
+    {
+        Translator<> runtime_translator{Dictionary<std::string>{{"dog", "pies"}}};
+
+        REQUIRE(runtime_translator.translate("dog") == translator.translate("dog"));
+        REQUIRE(runtime_translator.translate("cow") == "cow");
+    }
+}
+
+TEST_CASE("Translator - benchmarks", "[.][benchmark]")
+{
+    const std::vector<std::string> words = {"one", "dog", "window", "city", "elephant", "ten", "book", "unknown", "bread", "seven"};
+
+    Dictionary<std::string> runtime_dictionary;
+    for (const auto& word : words)
+    {
+        if (en_pl_dictionary.contains(word))
+            runtime_dictionary[word] = std::string(en_pl_dictionary.at(word));
+    }
+
+    const Translator<> runtime_translator{runtime_dictionary};
+    constexpr Translator<StaticDictionary<20>> static_translator{en_pl_dictionary};
+
+    BENCHMARK("Translator<Dictionary<std::string>> - lookup")
+    {
+        size_t length = 0;
+        for (const auto& word : words)
+            length += runtime_translator.translate(word).size();
+        return length;
+    };
+
+    BENCHMARK("Translator<StaticDictionary> - lookup")
+    {
+        size_t length = 0;
+        for (const auto& word : words)
+            length += static_translator.translate(word).size();
+        return length;
+    };
+
+    BENCHMARK("Translator<Dictionary<std::string>> - construction")
+    {
+        return Translator<>{runtime_dictionary};
+    };
+}
+
+TEST_CASE("my_find - vectorized for arithmetic types")
+{
+    SECTION("Buffer<uint8_t>")
+    {
+        Buffer<uint8_t> buffer = {};
+
+        REQUIRE(my_find(buffer.begin(), buffer.end(), 42) == buffer.end());
+
+        for (size_t i : {0, 15, 16, 31, 32, 500, 1023})
+        {
+            buffer[i] = 42;
+            REQUIRE(my_find(buffer.begin(), buffer.end(), 42) == buffer.begin() + i);
+            buffer[i] = 0;
+        }
+    }
+
+    SECTION("LargeBuffer<uint8_t> with value out of item's range")
+    {
+        LargeBuffer<uint8_t> large_buffer = {};
+        large_buffer[2000] = 255;
+
+        REQUIRE(my_find(large_buffer.begin(), large_buffer.end(), 255) == large_buffer.begin() + 2000);
+        REQUIRE(my_find(large_buffer.begin(), large_buffer.end(), 255 + 256) == large_buffer.end());
+        REQUIRE(my_find(large_buffer.begin(), large_buffer.end(), -1) == large_buffer.end());
+    }
+
+    SECTION("vector of ints - every position including tail")
+    {
+        std::vector<int> numbers(77);
+        for (size_t i = 0; i < numbers.size(); ++i)
+            numbers[i] = static_cast<int>(i) - 10;
+
+        for (int value = -11; value <= 67; ++value)
+            REQUIRE(my_find(numbers.begin(), numbers.end(), value) == std::find(numbers.begin(), numbers.end(), value));
+    }
+
+    SECTION("same result as scalar loop for mixed signedness")
+    {
+        std::vector<unsigned int> numbers = {1, 2, 3, 4, 5, 0xFFFFFFFF, 7};
+
+        REQUIRE(my_find(numbers.begin(), numbers.end(), -1) == numbers.begin() + 5);
+    }
+
+    SECTION("64-bit integers and floating point")
+    {
+        std::vector<int64_t> big(33, 1LL << 40);
+        big[17] = (1LL << 40) + 1;
+        REQUIRE(my_find(big.begin(), big.end(), (1LL << 40) + 1) == big.begin() + 17);
+        REQUIRE(my_find(big.begin(), big.end(), 1) == big.end());
+
+        std::vector<double> values = {0.5, 1.5, 2.5, -0.0, 3.5};
+        REQUIRE(my_find(values.begin(), values.end(), 0.0) == values.begin() + 3);
+        REQUIRE(my_find(values.begin(), values.end(), 4.5) == values.end());
+    }
+
+#ifdef SIMD_FIND_AVX2
+    SECTION("AVX2 and SSE2 kernels agree")
+    {
+        std::vector<uint16_t> items(1000);
+        for (size_t i = 0; i < items.size(); ++i)
+            items[i] = static_cast<uint16_t>(i * 7);
+
+        for (uint16_t value : {0, 7, 700, 6993, 1})
+        {
+            const uint16_t* expected = std::find(items.data(), items.data() + items.size(), value);
+
+            REQUIRE(Simd::Detail::find_sse2(items.data(), items.data() + items.size(), value) == expected);
+            if (Simd::Detail::cpu_has_avx2())
+                REQUIRE(Simd::Detail::find_avx2(items.data(), items.data() + items.size(), value) == expected);
+        }
+    }
+#endif
+}
+
+namespace ver_1_0
+{
+    template <typename Iterator, typename TValue>
+    Iterator my_find(Iterator begin, Iterator end, const TValue& value)
+    {
+        for (Iterator pos = begin; pos != end; ++pos)
+        {
+            if (*pos == value)
+                return pos;
+        }
+
+        return end;
+    }
+} // namespace ver_1_0
+
+TEST_CASE("my_find - benchmarks", "[.][benchmark]")
+{
+    std::vector<uint8_t> bytes(64 * 1024 * 1024);
+    std::vector<int> ints(16 * 1024 * 1024);
+
+    const std::pair<const char*, double> positions[] = {{"start", 0.0}, {"middle", 0.5}, {"end", 1.0}, {"no match", -1.0}};
+
+    for (const auto& [desc, position] : positions)
+    {
+        std::fill(bytes.begin(), bytes.end(), uint8_t{0});
+        std::fill(ints.begin(), ints.end(), 0);
+
+        if (position >= 0.0)
+        {
+            bytes[static_cast<size_t>(position * (bytes.size() - 1))] = 42;
+            ints[static_cast<size_t>(position * (ints.size() - 1))] = 42;
+        }
+
+        BENCHMARK(std::string("scalar my_find - uint8_t - ") + desc)
+        {
+            return ver_1_0::my_find(bytes.begin(), bytes.end(), 42);
+        };
+
+        BENCHMARK(std::string("simd my_find - uint8_t - ") + desc)
+        {
+            return my_find(bytes.begin(), bytes.end(), 42);
+        };
+
+        BENCHMARK(std::string("scalar my_find - int - ") + desc)
+        {
+            return ver_1_0::my_find(ints.begin(), ints.end(), 42);
+        };
+
+        BENCHMARK(std::string("simd my_find - int - ") + desc)
+        {
+            return my_find(ints.begin(), ints.end(), 42);
+        };
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
 
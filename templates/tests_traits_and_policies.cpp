@@ -1,11 +1,399 @@
+#include "policy_container.hpp"
+#include "relocating_vector.hpp"
+
+#include <array>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// resource owning class (like Data from move-semantics, without the std::string name -
+// libstdc++ strings point into themselves, so they cannot be relocated with memcpy)
+class Data
+{
+    int* data_;
+    size_t size_;
+
+public:
+    using is_trivially_relocatable = std::true_type;
+
+    inline static size_t move_count = 0;
+
+    explicit Data(size_t size = 0)
+        : data_{new int[size]}
+        , size_{size}
+    {
+        std::iota(data_, data_ + size_, 0);
+    }
+
+    Data(const Data& other)
+        : data_{new int[other.size_]}
+        , size_{other.size_}
+    {
+        std::copy(other.data_, other.data_ + size_, data_);
+    }
+
+    Data& operator=(const Data& other)
+    {
+        Data temp(other);
+        std::swap(data_, temp.data_);
+        std::swap(size_, temp.size_);
+        return *this;
+    }
+
+    Data(Data&& source) noexcept
+        : data_{std::exchange(source.data_, nullptr)}
+        , size_{std::exchange(source.size_, 0)}
+    {
+        ++move_count;
+    }
+
+    Data& operator=(Data&& source) noexcept
+    {
+        Data temp(std::move(source));
+        std::swap(data_, temp.data_);
+        std::swap(size_, temp.size_);
+        return *this;
+    }
+
+    ~Data()
+    {
+        delete[] data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+};
+
+// keeps a pointer to its own member - must be moved with its move constructor
+class SelfReferencing
+{
+    int value_;
+    int* ptr_ = &value_;
+
+public:
+    SelfReferencing(int value)
+        : value_{value}
+    { }
+
+    SelfReferencing(const SelfReferencing& other)
+        : value_{other.value()}
+    { }
+
+    SelfReferencing& operator=(const SelfReferencing& other)
+    {
+        value_ = other.value();
+        return *this;
+    }
+
+    int value() const
+    {
+        return *ptr_;
+    }
+};
 
 TEST_CASE("using traits")
-{   
-    // TODO   
+{
+    SECTION("is_trivially_relocatable")
+    {
+        static_assert(is_trivially_relocatable_v<int>);
+        static_assert(is_trivially_relocatable_v<std::array<double, 4>>);
+        static_assert(is_trivially_relocatable_v<std::unique_ptr<std::string>>);
+        static_assert(is_trivially_relocatable_v<std::shared_ptr<int>>);
+        static_assert(is_trivially_relocatable_v<Data>);     // opt-in
+        static_assert(is_trivially_relocatable_v<const Data>);
+        static_assert(!is_trivially_relocatable_v<SelfReferencing>);
+    }
+
+    SECTION("growth relocates opted-in items without moves")
+    {
+        RelocatingVector<Data> items;
+        Data::move_count = 0;
+
+        for (size_t i = 0; i < 100; ++i)
+            items.emplace_back(i);
+
+        REQUIRE(Data::move_count == 0);
+        REQUIRE(items.size() == 100);
+        for (size_t i = 0; i < 100; ++i)
+            REQUIRE(items[i].size() == i);
+    }
+
+    SECTION("erase closes the gap")
+    {
+        RelocatingVector<std::unique_ptr<int>> ptrs;
+        for (int i = 0; i < 10; ++i)
+            ptrs.push_back(std::make_unique<int>(i));
+
+        auto pos = ptrs.erase(ptrs.begin());
+        REQUIRE(pos == ptrs.begin());
+        REQUIRE(**pos == 1);
+        pos = ptrs.erase(ptrs.begin() + 2, ptrs.begin() + 5);
+        REQUIRE(**pos == 6);
+
+        std::vector<int> values;
+        for (const auto& ptr : ptrs)
+            values.push_back(*ptr);
+        REQUIRE(values == std::vector<int>{1, 2, 6, 7, 8, 9});
+    }
+
+    SECTION("other types are moved item by item")
+    {
+        RelocatingVector<SelfReferencing> items;
+        for (int i = 0; i < 20; ++i)
+            items.push_back(i);
+
+        items.erase(items.begin(), items.begin() + 5);
+
+        REQUIRE(items.size() == 15);
+        for (int i = 0; i < 15; ++i)
+            REQUIRE(items[i].value() == i + 5);
+    }
+
+    SECTION("push_back of own item while growing")
+    {
+        RelocatingVector<std::string> words = {"one", "two", "three", "four", "five", "six", "seven", "eight"};
+        REQUIRE(words.size() == words.capacity());
+
+        words.push_back(words[0]);
+        REQUIRE(words.back() == "one");
+    }
 }
 
+template <typename TContainer>
+concept HasCapacity = requires(const TContainer& container) { container.capacity(); };
+
 TEST_CASE("using policies - Policy Based Design")
 {
-    // TODO
-}
\ No newline at end of file
+    SECTION("default policies - single threaded vector")
+    {
+        Container<std::string> words;
+        words.push_back("one");
+        words.emplace_back(3, 'a');
+
+        REQUIRE(words.size() == 2);
+        REQUIRE(words.at(1) == "aaa");
+        REQUIRE_THROWS_AS(words.at(2), std::out_of_range);
+
+        std::string last;
+        REQUIRE(words.try_pop_back(last));
+        REQUIRE(last == "aaa");
+        REQUIRE(words.size() == 1);
+    }
+
+    SECTION("no locking - no space & time overhead")
+    {
+        static_assert(sizeof(Container<int>) == sizeof(std::vector<int>));
+        static_assert(sizeof(Container<int, StoragePolicies::Vector, LockingPolicies::Mutex>) > sizeof(std::vector<int>));
+    }
+
+    SECTION("growth policies")
+    {
+        auto capacities = [](auto& container) {
+            std::vector<size_t> result;
+            for (int i = 0; i < 100; ++i)
+            {
+                container.push_back(i);
+                if (result.empty() || result.back() != container.capacity())
+                    result.push_back(container.capacity());
+            }
+            return result;
+        };
+
+        Container<int, StoragePolicies::Vector, LockingPolicies::None, GrowthPolicies::Factor1_5> by_half;
+        REQUIRE(capacities(by_half) == std::vector<size_t>{8, 12, 18, 27, 40, 60, 90, 135});
+
+        Container<int, StoragePolicies::Vector, LockingPolicies::None, GrowthPolicies::Factor2> doubled;
+        REQUIRE(capacities(doubled) == std::vector<size_t>{8, 16, 32, 64, 128});
+
+        Container<int, StoragePolicies::Vector, LockingPolicies::None, GrowthPolicies::Chunks<40>> chunked;
+        REQUIRE(capacities(chunked) == std::vector<size_t>{40, 80, 120});
+    }
+
+    SECTION("inline storage")
+    {
+        Container<std::unique_ptr<int>, StoragePolicies::Inline<4>, LockingPolicies::None, GrowthPolicies::Chunks<4>> ptrs;
+        REQUIRE(ptrs.capacity() == 4);
+
+        for (int i = 0; i < 10; ++i)
+            ptrs.push_back(std::make_unique<int>(i));
+
+        REQUIRE(ptrs.capacity() == 12);
+
+        int sum = 0;
+        ptrs.for_each([&](const auto& ptr) { sum += *ptr; });
+        REQUIRE(sum == 45);
+    }
+
+    SECTION("storages without capacity ignore growth policies")
+    {
+        using DequeContainer = Container<int, StoragePolicies::Deque>;
+        static_assert(!HasCapacity<DequeContainer>);
+        static_assert(HasCapacity<Container<int>>);
+
+        DequeContainer numbers;
+        for (int i = 0; i < 100; ++i)
+            numbers.push_back(i);
+        REQUIRE(numbers.at(99) == 99);
+    }
+
+    SECTION("concurrent writers & readers")
+    {
+        auto stress = [](auto& container) {
+            constexpr int thread_count = 4;
+            constexpr int items_per_thread = 10'000;
+
+            {
+                std::vector<std::jthread> threads;
+                for (int t = 0; t < thread_count; ++t)
+                {
+                    threads.emplace_back([&] {
+                        for (int i = 0; i < items_per_thread; ++i)
+                        {
+                            container.push_back(1);
+                            container.at(container.size() - 1);
+                        }
+                    });
+                }
+            }
+
+            long sum = 0;
+            container.for_each([&](int item) { sum += item; });
+            return sum == thread_count * items_per_thread;
+        };
+
+        Container<int, StoragePolicies::Vector, LockingPolicies::Mutex> with_mutex;
+        REQUIRE(stress(with_mutex));
+
+        Container<int, StoragePolicies::Deque, LockingPolicies::Spinlock> with_spinlock;
+        REQUIRE(stress(with_spinlock));
+
+        Container<int, StoragePolicies::Inline<64>, LockingPolicies::ReaderWriter, GrowthPolicies::Factor1_5> with_shared_mutex;
+        REQUIRE(stress(with_shared_mutex));
+    }
+}
+
+namespace
+{
+    template <typename... Ts>
+    struct TypeList
+    { };
+
+    template <typename... Ts, typename TFunction>
+    void for_each_type(TypeList<Ts...>, TFunction f)
+    {
+        (f.template operator()<Ts>(), ...);
+    }
+
+    template <typename TContainer>
+    std::string policies_desc()
+    {
+        return std::string(TContainer::storage_policy::name) + ", " + std::string(TContainer::locking_policy::name) + ", "
+            + std::string(TContainer::growth_policy::name);
+    }
+} // namespace
+
+TEST_CASE("using traits - relocation benchmarks", "[.][benchmark]")
+{
+    auto run = [](auto make_item, const std::string& desc) {
+        for_each_type(TypeList<std::vector<decltype(make_item(0))>, RelocatingVector<decltype(make_item(0))>>{}, [&]<typename TVector>() {
+            const std::string container_desc = std::is_same_v<TVector, std::vector<typename TVector::value_type>> ? "std::vector" : "RelocatingVector";
+
+            BENCHMARK("growth - 100K - " + container_desc + "<" + desc + ">")
+            {
+                TVector items;
+                for (int i = 0; i < 100'000; ++i)
+                    items.push_back(make_item(i));
+                return items.size();
+            };
+
+            BENCHMARK_ADVANCED("erase from front - 10K - " + container_desc + "<" + desc + ">")(Catch::Benchmark::Chronometer meter)
+            {
+                std::vector<TVector> runs(meter.runs());
+                for (auto& items : runs)
+                    for (int i = 0; i < 10'000; ++i)
+                        items.push_back(make_item(i));
+
+                meter.measure([&](int run) {
+                    auto& items = runs[run];
+                    while (!items.empty())
+                        items.erase(items.begin());
+                    return items.size();
+                });
+            };
+        });
+    };
+
+    run([](int i) { return std::make_unique<int>(i); }, "std::unique_ptr<int>");
+    run([](int i) { return Data(i % 4); }, "Data");
+}
+
+TEST_CASE("using policies - benchmarks", "[.][benchmark]")
+{
+    using Storages = TypeList<StoragePolicies::Vector, StoragePolicies::Deque, StoragePolicies::Inline<256>>;
+    using Lockings = TypeList<LockingPolicies::None, LockingPolicies::Mutex, LockingPolicies::Spinlock, LockingPolicies::ReaderWriter>;
+    using Growths = TypeList<GrowthPolicies::Factor1_5, GrowthPolicies::Factor2, GrowthPolicies::Chunks<4096>>;
+
+    constexpr int item_count = 100'000;
+
+    // single thread - storage x growth x locking
+    for_each_type(Storages{}, [&]<typename TStorage>() {
+        for_each_type(Growths{}, [&]<typename TGrowth>() {
+            for_each_type(Lockings{}, [&]<typename TLocking>() {
+                using TContainer = Container<int, TStorage, TLocking, TGrowth>;
+
+                BENCHMARK("push_back 100K - " + policies_desc<TContainer>())
+                {
+                    TContainer container;
+                    for (int i = 0; i < item_count; ++i)
+                        container.push_back(i);
+                    return container.size();
+                };
+            });
+        });
+    });
+
+    // mixed workload (1 write per 8 reads) - locking x number of threads
+    for_each_type(Lockings{}, [&]<typename TLocking>() {
+        if constexpr (!std::is_same_v<TLocking, LockingPolicies::None>)
+        {
+            using TContainer = Container<int, StoragePolicies::Vector, TLocking, GrowthPolicies::Factor2>;
+
+            for (int thread_count : {1, 2, 4, 8})
+            {
+                BENCHMARK("mixed 100K ops - " + std::to_string(thread_count) + " threads - " + policies_desc<TContainer>())
+                {
+                    TContainer container;
+                    container.push_back(0);
+                    std::atomic<long> checksum{0};
+
+                    std::vector<std::jthread> threads;
+                    for (int t = 0; t < thread_count; ++t)
+                    {
+                        threads.emplace_back([&] {
+                            long sum = 0;
+                            for (int i = 0; i < item_count / thread_count; ++i)
+                            {
+                                if (i % 9 == 0)
+                                    container.push_back(i);
+                                else
+                                    sum += container.at(i % container.size());
+                            }
+                            checksum += sum;
+                        });
+                    }
+                    threads.clear();
+
+                    return checksum.load() + container.size();
+                };
+            }
+        }
+    });
+}